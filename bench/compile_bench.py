@@ -0,0 +1,27 @@
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+parser = argparse.ArgumentParser(
+    description="Measures compile time and peak memory of a source for set of alternative counts")
+parser.add_argument("--cxx", required=True, help="C++ compiler")
+parser.add_argument("--include", required=True, help="vari include directory")
+parser.add_argument("--src", required=True, help="source to compile, has to use VARI_BENCH_N")
+parser.add_argument("--flag", action="append", default=[], help="extra compiler flag")
+parser.add_argument("n", type=int, nargs="+", help="alternative counts to measure")
+args = parser.parse_args()
+
+print(f"{'N':>6} {'time [s]':>10} {'peak RSS [MiB]':>16}")
+for n in args.n:
+    cmd = [args.cxx, "-std=c++20", f"-I{args.include}", f"-DVARI_BENCH_N={n}",
+           "-ftemplate-depth=4096", *args.flag, "-c", args.src, "-o", os.devnull]
+    start = time.monotonic()
+    proc = subprocess.Popen(cmd)
+    _, status, usage = os.wait4(proc.pid, 0)
+    elapsed = time.monotonic() - start
+    if os.waitstatus_to_exitcode(status) != 0:
+        print(f"compilation failed for N={n}: {' '.join(cmd)}", file=sys.stderr)
+        sys.exit(1)
+    print(f"{n:>6} {elapsed:>10.2f} {usage.ru_maxrss / 1024:>16.1f}")
@@ -0,0 +1,130 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+// Runtime benchmark of `visit` latency over a value variadic with `VARI_BENCH_N` alternatives. For
+// each dispatch strategy it visits values whose indexes are drawn from a narrow window at several
+// positions of the set, so that the cost of reaching the tail of the set is visible. Build with
+// optimizations enabled.
+
+#include "vari/dispatch.h"
+#include "vari/vval.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#ifndef VARI_BENCH_N
+#define VARI_BENCH_N 180
+#endif
+
+// Width of the window of indexes, 1 makes all branches predictable.
+#ifndef VARI_BENCH_WINDOW
+#define VARI_BENCH_WINDOW 16
+#endif
+
+template < std::size_t I >
+struct bench_tag
+{
+        // Differs for each type, so that the compiler can't merge the visited branches.
+        static constexpr std::size_t k = ( I + 1 ) * 2654435761u;
+
+        std::size_t v = I;
+};
+
+template < typename Seq >
+struct bench_tags;
+
+template < std::size_t... Is >
+struct bench_tags< std::index_sequence< Is... > >
+{
+        using type = vari::typelist< bench_tag< Is >... >;
+};
+
+using bench_set = typename bench_tags< std::make_index_sequence< VARI_BENCH_N > >::type;
+using bench_val = vari::vval< bench_set >;
+
+static constexpr std::size_t values_count = 4096;
+static constexpr std::size_t window       = VARI_BENCH_WINDOW;
+static constexpr std::size_t repeats      = 2000;
+
+static std::vector< bench_val > make_values( std::size_t first )
+{
+        std::vector< bench_val > res;
+        res.reserve( values_count );
+        std::uint32_t seed = 42;
+        for ( std::size_t i = 0; i < values_count; i++ ) {
+                seed                 = seed * 1664525u + 1013904223u;
+                std::size_t const ix = first + ( seed >> 16 ) % window;
+                res.push_back( vari::dispatch< VARI_BENCH_N >(
+                    ix,
+                    [&]< vari::index_type j >() {
+                            return bench_tag< j >{};
+                    },
+                    [&]( auto tag ) {
+                            return bench_val{ tag };
+                    } ) );
+        }
+        return res;
+}
+
+template < vari::dispatch_strategy S >
+static double measure( std::vector< bench_val > const& values, std::size_t& sum )
+{
+        auto const start = std::chrono::steady_clock::now();
+        for ( std::size_t r = 0; r < repeats; r++ )
+                for ( bench_val const& v : values )
+                        sum += v.visit< S >( []( auto const& x ) {
+                                return x.v * x.k;
+                        } );
+        auto const end = std::chrono::steady_clock::now();
+
+        std::chrono::duration< double, std::nano > const d = end - start;
+        return d.count() / double( repeats * values_count );
+}
+
+int main()
+{
+        using vari::dispatch_strategy;
+
+        static constexpr std::size_t positions = 5;
+        std::size_t                  sum       = 0;
+
+        std::printf(
+            "N = %d, ns per visit of index in [first, first + %zu)\n", VARI_BENCH_N, window );
+        std::printf(
+            "%8s %12s %12s %12s %12s\n", "first", "jump_table", "fun_table", "binary", "if_chain" );
+        for ( std::size_t p = 0; p < positions; p++ ) {
+                std::size_t const first  = p * ( VARI_BENCH_N - window ) / ( positions - 1 );
+                auto const        values = make_values( first );
+
+                double const jt = measure< dispatch_strategy::jump_table >( values, sum );
+                double const ft = measure< dispatch_strategy::fun_table >( values, sum );
+                double const bt = measure< dispatch_strategy::binary >( values, sum );
+                double const ic = measure< dispatch_strategy::if_chain >( values, sum );
+                std::printf( "%8zu %12.3f %12.3f %12.3f %12.3f\n", first, jt, ft, bt, ic );
+        }
+
+        return sum == 0 ? 1 : 0;
+}
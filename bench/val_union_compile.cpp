@@ -0,0 +1,72 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+// Compile-time benchmark of value variadics with `VARI_BENCH_N` alternatives. Instantiates
+// construction, emplace, visit, copy and comparison for each alternative.
+
+#include "vari/vval.h"
+
+#include <utility>
+
+#ifndef VARI_BENCH_N
+#define VARI_BENCH_N 16
+#endif
+
+template < std::size_t I >
+struct bench_tag
+{
+        std::size_t v = I;
+
+        friend auto operator<=>( bench_tag const&, bench_tag const& ) = default;
+};
+
+template < typename Seq >
+struct bench_tags;
+
+template < std::size_t... Is >
+struct bench_tags< std::index_sequence< Is... > >
+{
+        using type = vari::typelist< bench_tag< Is >... >;
+};
+
+using bench_set = typename bench_tags< std::make_index_sequence< VARI_BENCH_N > >::type;
+
+int main()
+{
+        vari::vval< bench_set > v{ bench_tag< 0 >{} };
+        std::size_t             sum = 0;
+
+        [&]< std::size_t... Is >( std::index_sequence< Is... > ) {
+                ( ( v.template emplace< bench_tag< Is > >(),
+                    sum += v.visit( []( auto& x ) {
+                            return x.v;
+                    } ) ),
+                  ... );
+        }( std::make_index_sequence< VARI_BENCH_N >{} );
+
+        vari::vval< bench_set > c{ v };
+        if ( c != v )
+                return 1;
+
+        return sum == VARI_BENCH_N * ( VARI_BENCH_N - 1 ) / 2 ? 0 : 1;
+}
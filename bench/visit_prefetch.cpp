@@ -0,0 +1,133 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+// Runtime benchmark of `visit_range_prefetch` against plain `visit_range` over `uvptr`s to
+// `VARI_BENCH_COUNT` objects scattered over the heap. Objects of four types are allocated in random
+// order, so consecutive elements point to unrelated cache lines and nearly every visit misses the
+// cache. Build with optimizations enabled. Cache miss rates can be compared by running it under
+// `perf stat -e cache-misses,cache-references`.
+
+#include "vari/uvptr.h"
+#include "vari/visit.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#ifndef VARI_BENCH_COUNT
+#define VARI_BENCH_COUNT 10000000
+#endif
+
+template < std::size_t I >
+struct bench_obj
+{
+        // Differs for each type, so that the compiler can't merge the visited branches.
+        static constexpr std::uint64_t k = ( I + 1 ) * 2654435761u;
+
+        std::uint64_t v;
+        std::uint64_t pad[7];
+};
+
+using bench_ptr = vari::uvptr< bench_obj< 0 >, bench_obj< 1 >, bench_obj< 2 >, bench_obj< 3 > >;
+
+static std::vector< bench_ptr > make_values()
+{
+        std::mt19937_64                  gen{ 42 };
+        std::vector< bench_ptr >         res;
+        std::uniform_int_distribution<> type{ 0, 3 };
+        res.reserve( VARI_BENCH_COUNT );
+        for ( std::size_t i = 0; i < VARI_BENCH_COUNT; i++ ) {
+                switch ( type( gen ) ) {
+                case 0:
+                        res.emplace_back( vari::uwrap( bench_obj< 0 >{ i, {} } ) );
+                        break;
+                case 1:
+                        res.emplace_back( vari::uwrap( bench_obj< 1 >{ i, {} } ) );
+                        break;
+                case 2:
+                        res.emplace_back( vari::uwrap( bench_obj< 2 >{ i, {} } ) );
+                        break;
+                default:
+                        res.emplace_back( vari::uwrap( bench_obj< 3 >{ i, {} } ) );
+                        break;
+                }
+        }
+        // Visiting order unrelated to the allocation order
+        std::shuffle( res.begin(), res.end(), gen );
+        return res;
+}
+
+template < typename F >
+static double measure( std::size_t n, F&& f )
+{
+        static constexpr std::size_t repeats = 3;
+
+        auto const start = std::chrono::steady_clock::now();
+        for ( std::size_t r = 0; r < repeats; r++ )
+                f();
+        auto const end = std::chrono::steady_clock::now();
+
+        std::chrono::duration< double, std::nano > const d = end - start;
+        return d.count() / double( repeats * n );
+}
+
+template < std::size_t D >
+static void run( std::vector< bench_ptr > const& values, std::uint64_t& sum )
+{
+        double const t = measure( values.size(), [&] {
+                vari::visit_range_prefetch< D >(
+                    values,
+                    [&]( auto& x ) {
+                            sum += x.v * x.k;
+                    },
+                    [&]( vari::empty_t ) {} );
+        } );
+        std::printf( "%20s %2zu %8.3f\n", "visit_range_prefetch", D, t );
+}
+
+int main()
+{
+        auto const    values = make_values();
+        std::uint64_t sum    = 0;
+
+        std::printf( "%zu elements, ns per element\n", values.size() );
+        double const plain = measure( values.size(), [&] {
+                vari::visit_range(
+                    values,
+                    [&]( auto& x ) {
+                            sum += x.v * x.k;
+                    },
+                    [&]( vari::empty_t ) {} );
+        } );
+        std::printf( "%20s %2s %8.3f\n", "visit_range", "-", plain );
+        run< 2 >( values, sum );
+        run< 4 >( values, sum );
+        run< 8 >( values, sum );
+        run< 16 >( values, sum );
+        run< 32 >( values, sum );
+
+        return sum == 0 ? 1 : 0;
+}
@@ -0,0 +1,146 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+// Runtime benchmark of `visit_range` against a loop calling `visit` on each element. Values of a
+// variadic with `VARI_BENCH_N` alternatives are laid out randomly, sorted by index, or in clusters
+// of `VARI_BENCH_CLUSTER` elements of the same type. Build with optimizations enabled.
+
+#include "vari/dispatch.h"
+#include "vari/visit.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#ifndef VARI_BENCH_N
+#define VARI_BENCH_N 16
+#endif
+
+#ifndef VARI_BENCH_CLUSTER
+#define VARI_BENCH_CLUSTER 64
+#endif
+
+template < std::size_t I >
+struct bench_tag
+{
+        // Differs for each type, so that the compiler can't merge the visited branches.
+        static constexpr std::size_t k = ( I + 1 ) * 2654435761u;
+
+        std::size_t v = I;
+};
+
+template < typename Seq >
+struct bench_tags;
+
+template < std::size_t... Is >
+struct bench_tags< std::index_sequence< Is... > >
+{
+        using type = vari::typelist< bench_tag< Is >... >;
+};
+
+using bench_set = typename bench_tags< std::make_index_sequence< VARI_BENCH_N > >::type;
+using bench_val = vari::vval< bench_set >;
+
+static constexpr std::size_t values_count = 1 << 16;
+static constexpr std::size_t repeats      = 200;
+
+enum class layout
+{
+        random,
+        sorted,
+        clustered
+};
+
+static std::vector< bench_val > make_values( layout l )
+{
+        std::vector< std::size_t > ixs;
+        ixs.reserve( values_count );
+        std::uint32_t seed = 42;
+        for ( std::size_t i = 0; i < values_count; i++ ) {
+                seed = seed * 1664525u + 1013904223u;
+                if ( l == layout::clustered && i % VARI_BENCH_CLUSTER != 0 )
+                        ixs.push_back( ixs.back() );
+                else
+                        ixs.push_back( ( seed >> 16 ) % VARI_BENCH_N );
+        }
+        if ( l == layout::sorted )
+                std::sort( ixs.begin(), ixs.end() );
+
+        std::vector< bench_val > res;
+        res.reserve( values_count );
+        for ( std::size_t const ix : ixs )
+                res.push_back( vari::dispatch< VARI_BENCH_N >(
+                    ix,
+                    [&]< vari::index_type j >() {
+                            return bench_tag< j >{};
+                    },
+                    [&]( auto tag ) {
+                            return bench_val{ tag };
+                    } ) );
+        return res;
+}
+
+template < typename F >
+static double measure( F&& f )
+{
+        auto const start = std::chrono::steady_clock::now();
+        for ( std::size_t r = 0; r < repeats; r++ )
+                f();
+        auto const end = std::chrono::steady_clock::now();
+
+        std::chrono::duration< double, std::nano > const d = end - start;
+        return d.count() / double( repeats * values_count );
+}
+
+int main()
+{
+        std::size_t sum = 0;
+
+        std::printf( "N = %d, ns per element\n", VARI_BENCH_N );
+        std::printf( "%10s %12s %12s\n", "layout", "visit", "visit_range" );
+        for ( layout const l : { layout::random, layout::sorted, layout::clustered } ) {
+                auto const values = make_values( l );
+
+                double const naive = measure( [&] {
+                        for ( bench_val const& v : values )
+                                sum += v.visit( []( auto const& x ) {
+                                        return x.v * x.k;
+                                } );
+                } );
+                double const range = measure( [&] {
+                        vari::visit_range( values, [&]( auto const& x ) {
+                                sum += x.v * x.k;
+                        } );
+                } );
+
+                char const* name = l == layout::random ? "random" :
+                                   l == layout::sorted ? "sorted" :
+                                                         "clustered";
+                std::printf( "%10s %12.3f %12.3f\n", name, naive, range );
+        }
+
+        return sum == 0 ? 1 : 0;
+}
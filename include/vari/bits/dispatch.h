@@ -26,60 +26,57 @@
 #include "util.h"
 
 #include <cstddef>
+#include <type_traits>
 #include <utility>
 
 namespace vari
 {
 
-template < index_type Off, index_type N, typename F >
-constexpr decltype( auto ) _dispatch_index( index_type const i, F&& f )
+#ifndef VARI_DISPATCH_STRATEGY
+#define VARI_DISPATCH_STRATEGY automatic
+#endif
+
+/// Strategy used to map runtime index into call of template with the index as template argument.
+///
+/// - `jump_table` is `switch` with case for each index, compilers usually turn it into a jump
+///   table. Up to 256 indexes are handled by one switch, bigger sets nest one per 256 indexes.
+/// - `fun_table` is constant array of function pointers indexed by the index, single indirect
+///   call for any number of indexes, but the callable can't be inlined into the caller.
+/// - `binary` is a tree of `<` comparisons, `log2(N)` predictable-ish branches.
+/// - `if_chain` compares the index with each value in order, best for two or three indexes or when
+///   the first indexes are much more likely.
+/// - `automatic` picks one of the above based on the number of indexes.
+///
+/// Default for the library is selected by defining `VARI_DISPATCH_STRATEGY` to one of the names,
+/// `visit` and `dispatch` also accept the strategy as template argument for single calls.
+enum class dispatch_strategy
 {
-#define VARI_GEN_CASE( x )                           \
-        case Off + ( x ):                            \
-                if constexpr ( ( Off + ( x ) ) < N ) \
-                        return ( (F&&) f ).template operator()< Off + ( x ) >();
+        automatic,
+        jump_table,
+        fun_table,
+        binary,
+        if_chain,
+};
 
-        switch ( i ) {
-                VARI_GEN_CASE( 0 )
-                VARI_GEN_CASE( 1 )
-                VARI_GEN_CASE( 2 )
-                VARI_GEN_CASE( 3 )
-                VARI_GEN_CASE( 4 )
-                VARI_GEN_CASE( 5 )
-                VARI_GEN_CASE( 6 )
-                VARI_GEN_CASE( 7 )
-                VARI_GEN_CASE( 8 )
-                VARI_GEN_CASE( 9 )
-                VARI_GEN_CASE( 10 )
-                VARI_GEN_CASE( 11 )
-                VARI_GEN_CASE( 12 )
-                VARI_GEN_CASE( 13 )
-                VARI_GEN_CASE( 14 )
-                VARI_GEN_CASE( 15 )
-                VARI_GEN_CASE( 16 )
-                VARI_GEN_CASE( 17 )
-                VARI_GEN_CASE( 18 )
-                VARI_GEN_CASE( 19 )
-                VARI_GEN_CASE( 20 )
-                VARI_GEN_CASE( 21 )
-                VARI_GEN_CASE( 22 )
-                VARI_GEN_CASE( 23 )
-                VARI_GEN_CASE( 24 )
-                VARI_GEN_CASE( 25 )
-                VARI_GEN_CASE( 26 )
-                VARI_GEN_CASE( 27 )
-                VARI_GEN_CASE( 28 )
-                VARI_GEN_CASE( 29 )
-                VARI_GEN_CASE( 30 )
-                VARI_GEN_CASE( 31 )
-        default:
-                if constexpr ( N > Off + 32 )
-                        return _dispatch_index< Off + 32, N >( i, (F&&) f );
-        }
+static constexpr dispatch_strategy default_dispatch_strategy =
+    dispatch_strategy::VARI_DISPATCH_STRATEGY;
 
+/// Number of cases in the wide `switch`, index sets up to this size are dispatched with single
+/// jump.
+static constexpr index_type _dispatch_switch_wide = 256;
 
-#undef VARI_GEN_CASE
+/// Strategy used by `automatic` for `n` indexes.
+constexpr dispatch_strategy _select_dispatch_strategy( index_type n ) noexcept
+{
+        if ( n <= 3 )
+                return dispatch_strategy::if_chain;
+        if ( n <= _dispatch_switch_wide )
+                return dispatch_strategy::jump_table;
+        return dispatch_strategy::fun_table;
+}
 
+[[noreturn]] inline void _unreachable()
+{
 #if defined( __cpp_lib_unreachable )
         std::unreachable();
 #elif defined( _MSC_VER )
@@ -89,6 +86,149 @@ constexpr decltype( auto ) _dispatch_index( index_type const i, F&& f )
 #endif
 }
 
+#define VARI_GEN_CASE( x )                           \
+        case Off + ( x ):                            \
+                if constexpr ( ( Off + ( x ) ) < N ) \
+                        return ( (F&&) f ).template operator()< Off + ( x ) >();
+#define VARI_GEN_CASE_4( x )   \
+        VARI_GEN_CASE( x )     \
+        VARI_GEN_CASE( x + 1 ) \
+        VARI_GEN_CASE( x + 2 ) \
+        VARI_GEN_CASE( x + 3 )
+#define VARI_GEN_CASE_16( x )     \
+        VARI_GEN_CASE_4( x )      \
+        VARI_GEN_CASE_4( x + 4 )  \
+        VARI_GEN_CASE_4( x + 8 )  \
+        VARI_GEN_CASE_4( x + 12 )
+#define VARI_GEN_CASE_64( x )      \
+        VARI_GEN_CASE_16( x )      \
+        VARI_GEN_CASE_16( x + 16 ) \
+        VARI_GEN_CASE_16( x + 32 ) \
+        VARI_GEN_CASE_16( x + 48 )
+
+// Switch is generated in two widths: 32 cases for small sets, as each case costs compile time even
+// when discarded, and `_dispatch_switch_wide` cases for large ones, so that those are dispatched by
+// one jump instead of a chain of nested 32 case switches. Sets bigger than the wide switch continue
+// in another switch from the `default` case.
+template < index_type Off, index_type N, typename F >
+constexpr decltype( auto ) _dispatch_switch( index_type const i, F&& f )
+{
+        if constexpr ( N - Off > 32 ) {
+                switch ( i ) {
+                        VARI_GEN_CASE_64( 0 )
+                        VARI_GEN_CASE_64( 64 )
+                        VARI_GEN_CASE_64( 128 )
+                        VARI_GEN_CASE_64( 192 )
+                default:
+                        if constexpr ( N > Off + _dispatch_switch_wide )
+                                return _dispatch_switch< Off + _dispatch_switch_wide, N >(
+                                    i, (F&&) f );
+                }
+        } else {
+                switch ( i ) {
+                        VARI_GEN_CASE_16( 0 )
+                        VARI_GEN_CASE_16( 16 )
+                default:
+                        break;
+                }
+        }
+
+        _unreachable();
+}
+
+#undef VARI_GEN_CASE_64
+#undef VARI_GEN_CASE_16
+#undef VARI_GEN_CASE_4
+#undef VARI_GEN_CASE
+
+template < typename R, typename F, index_type Off, typename Seq >
+struct _dispatch_fun_table;
+
+template < typename R, typename F, index_type Off, index_type... Is >
+struct _dispatch_fun_table< R, F, Off, std::integer_sequence< index_type, Is... > >
+{
+        template < index_type j >
+        static constexpr R call( std::remove_reference_t< F >& f )
+        {
+                return ( (F&&) f ).template operator()< j >();
+        }
+
+        static constexpr R ( *table[] )( std::remove_reference_t< F >& ) = { &call< Off + Is >... };
+};
+
+template < index_type Off, index_type N, typename F >
+constexpr decltype( auto ) _dispatch_table( index_type const i, F&& f )
+{
+        using R   = decltype( ( (F&&) f ).template operator()< Off >() );
+        using seq = std::make_integer_sequence< index_type, N - Off >;
+        return _dispatch_fun_table< R, F, Off, seq >::table[i - Off]( f );
+}
+
+template < index_type Lo, index_type Hi, typename F >
+constexpr decltype( auto ) _dispatch_binary( index_type const i, F&& f )
+{
+        if constexpr ( Hi - Lo == 1 ) {
+                return ( (F&&) f ).template operator()< Lo >();
+        } else {
+                constexpr index_type mid = Lo + ( Hi - Lo ) / 2;
+                if ( i < mid )
+                        return _dispatch_binary< Lo, mid >( i, (F&&) f );
+                return _dispatch_binary< mid, Hi >( i, (F&&) f );
+        }
+}
+
+template < index_type j, index_type N, typename F >
+constexpr decltype( auto ) _dispatch_chain( index_type const i, F&& f )
+{
+        if constexpr ( j + 1 == N ) {
+                return ( (F&&) f ).template operator()< j >();
+        } else {
+                if ( i == j )
+                        return ( (F&&) f ).template operator()< j >();
+                return _dispatch_chain< j + 1, N >( i, (F&&) f );
+        }
+}
+
+// Calls `f.template operator()< i >()` for runtime `i` in range `Off..N-1`, any other value is
+// undefined behavior.
+template <
+    index_type        Off,
+    index_type        N,
+    dispatch_strategy S = default_dispatch_strategy,
+    typename F >
+constexpr decltype( auto ) _dispatch_index( index_type const i, F&& f )
+{
+        constexpr dispatch_strategy s =
+            S == dispatch_strategy::automatic ? _select_dispatch_strategy( N - Off ) : S;
+
+        if constexpr ( N == Off )
+                _unreachable();
+        else if constexpr ( s == dispatch_strategy::fun_table )
+                return _dispatch_table< Off, N >( i, (F&&) f );
+        else if constexpr ( s == dispatch_strategy::binary )
+                return _dispatch_binary< Off, N >( i, (F&&) f );
+        else if constexpr ( s == dispatch_strategy::if_chain )
+                return _dispatch_chain< Off, N >( i, (F&&) f );
+        else
+                return _dispatch_switch< Off, N >( i, (F&&) f );
+}
+
+// Like `_dispatch_index`, but `L` is compared first in a branch marked as likely, only other values
+// go through the dispatch selected by `S`.
+template <
+    index_type        L,
+    index_type        Off,
+    index_type        N,
+    dispatch_strategy S = default_dispatch_strategy,
+    typename F >
+constexpr decltype( auto ) _dispatch_likely( index_type const i, F&& f )
+{
+        static_assert( Off <= L && L < N );
+        if ( i == L ) [[likely]]
+                return ( (F&&) f ).template operator()< L >();
+        return _dispatch_index< Off, N, S >( i, (F&&) f );
+}
+
 template < typename T, typename... Fs >
 constexpr decltype( auto ) _dispatch_fun( T&& item, Fs&&... fs )
 {
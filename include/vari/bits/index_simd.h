@@ -0,0 +1,249 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// SIMD kernels are compiled for x86-64 with GCC or Clang, the AVX2 variants are selected at
+// runtime. Define `VARI_DISABLE_SIMD` to use only the scalar kernels.
+#if !defined( VARI_DISABLE_SIMD ) && defined( __x86_64__ ) && \
+    ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define VARI_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define VARI_SIMD_X86 0
+#endif
+
+namespace vari
+{
+
+/// Number of elements covered by one word of a match mask.
+static constexpr std::size_t _match_block = 64;
+
+// Sets bit `i` of `res[b]` if element `b * 64 + i` of `p` equals any of `set`. Processes `blocks`
+// full blocks of 64 elements.
+template < typename E, std::size_t K >
+using _match_blocks_fn = void ( * )(
+    E const*                  p,
+    std::size_t               blocks,
+    std::array< E, K > const& set,
+    std::uint64_t*            res ) noexcept;
+
+// Mask of the first `n` elements of `p`, `n` is at most 64. Matches are first stored as bytes,
+// which the compiler can vectorize, and then packed eight at a time by a multiplication that moves
+// each byte's lowest bit into the top byte.
+template < typename E, std::size_t K >
+std::uint64_t _match_partial( E const* p, std::size_t n, std::array< E, K > const& set ) noexcept
+{
+        std::uint8_t hits[64] = {};
+        for ( std::size_t i = 0; i < n; i++ ) {
+                bool hit = false;
+                for ( E const s : set )
+                        hit |= p[i] == s;
+                hits[i] = hit;
+        }
+        std::uint64_t m = 0;
+        for ( std::size_t g = 0; g < 8; g++ ) {
+                std::uint64_t x = 0;
+                for ( std::size_t k = 0; k < 8; k++ )
+                        x |= std::uint64_t{ hits[8 * g + k] } << ( 8 * k );
+                m |= ( ( x * 0x0102040810204080u ) >> 56 ) << ( 8 * g );
+        }
+        return m;
+}
+
+template < typename E, std::size_t K >
+void _match_blocks_scalar(
+    E const*                  p,
+    std::size_t               blocks,
+    std::array< E, K > const& set,
+    std::uint64_t*            res ) noexcept
+{
+        for ( std::size_t b = 0; b < blocks; b++, p += _match_block )
+                res[b] = _match_partial( p, _match_block, set );
+}
+
+#if VARI_SIMD_X86
+
+template < typename E >
+inline __m128i _sse2_set1( E x ) noexcept
+{
+        if constexpr ( sizeof( E ) == 1 )
+                return _mm_set1_epi8( static_cast< char >( x ) );
+        else if constexpr ( sizeof( E ) == 2 )
+                return _mm_set1_epi16( static_cast< short >( x ) );
+        else
+                return _mm_set1_epi32( static_cast< int >( x ) );
+}
+
+template < typename E >
+inline __m128i _sse2_cmpeq( __m128i a, __m128i b ) noexcept
+{
+        if constexpr ( sizeof( E ) == 1 )
+                return _mm_cmpeq_epi8( a, b );
+        else if constexpr ( sizeof( E ) == 2 )
+                return _mm_cmpeq_epi16( a, b );
+        else
+                return _mm_cmpeq_epi32( a, b );
+}
+
+// One bit per element of the comparison result.
+template < typename E >
+inline std::uint64_t _sse2_movemask( __m128i m ) noexcept
+{
+        if constexpr ( sizeof( E ) == 1 )
+                return static_cast< std::uint32_t >( _mm_movemask_epi8( m ) );
+        else if constexpr ( sizeof( E ) == 2 )
+                return static_cast< std::uint32_t >(
+                    _mm_movemask_epi8( _mm_packs_epi16( m, _mm_setzero_si128() ) ) );
+        else
+                return static_cast< std::uint32_t >( _mm_movemask_ps( _mm_castsi128_ps( m ) ) );
+}
+
+template < typename E, std::size_t K >
+void _match_blocks_sse2(
+    E const*                  p,
+    std::size_t               blocks,
+    std::array< E, K > const& set,
+    std::uint64_t*            res ) noexcept
+{
+        static_assert( K > 0, "Empty sets are handled without the kernels" );
+        static constexpr std::size_t lanes = 16 / sizeof( E );
+
+        __m128i sv[K];
+        for ( std::size_t j = 0; j < K; j++ )
+                sv[j] = _sse2_set1( set[j] );
+
+        for ( std::size_t b = 0; b < blocks; b++, p += _match_block ) {
+                std::uint64_t m = 0;
+                for ( std::size_t i = 0; i < _match_block; i += lanes ) {
+                        __m128i const v =
+                            _mm_loadu_si128( reinterpret_cast< __m128i const* >( p + i ) );
+                        __m128i acc = _mm_setzero_si128();
+                        for ( std::size_t j = 0; j < K; j++ )
+                                acc = _mm_or_si128( acc, _sse2_cmpeq< E >( v, sv[j] ) );
+                        m |= _sse2_movemask< E >( acc ) << i;
+                }
+                res[b] = m;
+        }
+}
+
+template < typename E >
+__attribute__( ( target( "avx2" ) ) ) inline __m256i _avx2_set1( E x ) noexcept
+{
+        if constexpr ( sizeof( E ) == 1 )
+                return _mm256_set1_epi8( static_cast< char >( x ) );
+        else if constexpr ( sizeof( E ) == 2 )
+                return _mm256_set1_epi16( static_cast< short >( x ) );
+        else
+                return _mm256_set1_epi32( static_cast< int >( x ) );
+}
+
+template < typename E >
+__attribute__( ( target( "avx2" ) ) ) inline __m256i _avx2_cmpeq( __m256i a, __m256i b ) noexcept
+{
+        if constexpr ( sizeof( E ) == 1 )
+                return _mm256_cmpeq_epi8( a, b );
+        else if constexpr ( sizeof( E ) == 2 )
+                return _mm256_cmpeq_epi16( a, b );
+        else
+                return _mm256_cmpeq_epi32( a, b );
+}
+
+template < typename E, std::size_t K >
+__attribute__( ( target( "avx2" ) ) ) inline __m256i
+_avx2_match( E const* p, __m256i const ( &sv )[K] ) noexcept
+{
+        __m256i const v   = _mm256_loadu_si256( reinterpret_cast< __m256i const* >( p ) );
+        __m256i       acc = _mm256_setzero_si256();
+        for ( std::size_t j = 0; j < K; j++ )
+                acc = _mm256_or_si256( acc, _avx2_cmpeq< E >( v, sv[j] ) );
+        return acc;
+}
+
+template < typename E, std::size_t K >
+__attribute__( ( target( "avx2" ) ) ) void _match_blocks_avx2(
+    E const*                  p,
+    std::size_t               blocks,
+    std::array< E, K > const& set,
+    std::uint64_t*            res ) noexcept
+{
+        static_assert( K > 0, "Empty sets are handled without the kernels" );
+        __m256i sv[K];
+        for ( std::size_t j = 0; j < K; j++ )
+                sv[j] = _avx2_set1( set[j] );
+
+        for ( std::size_t b = 0; b < blocks; b++, p += _match_block ) {
+                std::uint64_t m = 0;
+                if constexpr ( sizeof( E ) == 1 ) {
+                        for ( std::size_t i = 0; i < _match_block; i += 32 )
+                                m |= std::uint64_t{ static_cast< std::uint32_t >(
+                                         _mm256_movemask_epi8( _avx2_match( p + i, sv ) ) ) }
+                                     << i;
+                } else if constexpr ( sizeof( E ) == 2 ) {
+                        // Packing works within 128-bit lanes, the permutation restores the order.
+                        for ( std::size_t i = 0; i < _match_block; i += 32 ) {
+                                __m256i const packed = _mm256_permute4x64_epi64(
+                                    _mm256_packs_epi16(
+                                        _avx2_match( p + i, sv ), _avx2_match( p + i + 16, sv ) ),
+                                    0xD8 );
+                                m |= std::uint64_t{ static_cast< std::uint32_t >(
+                                         _mm256_movemask_epi8( packed ) ) }
+                                     << i;
+                        }
+                } else {
+                        for ( std::size_t i = 0; i < _match_block; i += 8 )
+                                m |= std::uint64_t{ static_cast< std::uint32_t >(
+                                         _mm256_movemask_ps(
+                                             _mm256_castsi256_ps( _avx2_match( p + i, sv ) ) ) ) }
+                                     << i;
+                }
+                res[b] = m;
+        }
+}
+
+inline bool _cpu_has_avx2() noexcept
+{
+        static bool const res = __builtin_cpu_supports( "avx2" );
+        return res;
+}
+
+#endif
+
+// Kernel for the current CPU, selected once.
+template < typename E, std::size_t K >
+_match_blocks_fn< E, K > _match_blocks_kernel() noexcept
+{
+#if VARI_SIMD_X86
+        static _match_blocks_fn< E, K > const res =
+            _cpu_has_avx2() ? &_match_blocks_avx2< E, K > : &_match_blocks_sse2< E, K >;
+        return res;
+#else
+        return &_match_blocks_scalar< E, K >;
+#endif
+}
+
+}  // namespace vari
@@ -0,0 +1,162 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+
+#include <type_traits>
+
+#ifdef VARI_PROFILE_VISITS
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+#endif
+
+namespace vari
+{
+
+#ifdef VARI_PROFILE_VISITS
+
+/// Histograms of all typelists visited so far. On destruction, which happens at exit, they are
+/// appended to the file named by the `VARI_PROFILE_FILE` environment variable, `vari_profile.txt`
+/// by default. Each histogram is written as a `set` line followed by one line per type with the
+/// number of visits and the name of the type, and a `null` line.
+struct _visit_profile
+{
+        using dump_fn = void ( * )( std::FILE* );
+
+        std::mutex             m;
+        std::vector< dump_fn > dumps;
+
+        static _visit_profile& get()
+        {
+                static _visit_profile p;
+                return p;
+        }
+
+        bool add( dump_fn f )
+        {
+                std::lock_guard g{ m };
+                dumps.push_back( f );
+                return true;
+        }
+
+        ~_visit_profile()
+        {
+                char const* path = std::getenv( "VARI_PROFILE_FILE" );
+                std::FILE*  f    = std::fopen( path ? path : "vari_profile.txt", "a" );
+                if ( !f )
+                        return;
+                for ( dump_fn d : dumps )
+                        d( f );
+                std::fclose( f );
+        }
+};
+
+template < typename TL >
+struct _visit_histogram;
+
+template < typename... Ts >
+struct _visit_histogram< typelist< Ts... > >
+{
+        static constexpr std::size_t n = sizeof...( Ts );
+
+        // Entry `n` counts null
+        static inline std::atomic< std::uint64_t > counts[n + 1] = {};
+
+        static void dump( std::FILE* f )
+        {
+                std::fprintf( f, "set %zu\n", n );
+                std::size_t j = 0;
+                ( ( std::fprintf(
+                        f,
+                        "%llu %.*s\n",
+                        static_cast< unsigned long long >( counts[j++].load() ),
+                        static_cast< int >( _type_name< Ts >().size() ),
+                        _type_name< Ts >().data() ) ),
+                  ... );
+                std::fprintf(
+                    f, "null %llu\n", static_cast< unsigned long long >( counts[n].load() ) );
+        }
+
+        static inline bool const registered = _visit_profile::get().add( &dump );
+
+        static void record( index_type const i ) noexcept
+        {
+                (void) registered;
+                counts[i >= n ? n : i].fetch_add( 1, std::memory_order_relaxed );
+        }
+};
+
+#endif
+
+#ifdef VARI_PROFILE_VISITS
+
+template < typename T, typename... Ks >
+constexpr index_type _exact_index( typelist< Ks... > )
+{
+        index_type i = 0;
+        ( ( !std::is_same_v< T, Ks > && ++i ) && ... );
+        return i;
+}
+
+// Index of each type of `TL` in its origin set, see `typelist_origin`
+template < typename TL, typename KL = typename typelist_origin< TL >::type >
+struct _profile_key;
+
+template < typename... Ts, typename KL >
+struct _profile_key< typelist< Ts... >, KL >
+{
+        static_assert(
+            KL::size == sizeof...( Ts ) && is_subset_v< typelist< Ts... >, KL > &&
+                is_subset_v< KL, typelist< Ts... > >,
+            "typelist_origin has to alias a permutation of the typelist" );
+
+        using type = KL;
+
+        static constexpr index_type index[] = { _exact_index< Ts >( KL{} )..., 0 };
+};
+
+#endif
+
+/// Records visit of index `i` of typelist `TL` when `VARI_PROFILE_VISITS` is defined, does nothing
+/// otherwise. `i` may be `null_index` or `TL::size` for null. The visit is recorded under the
+/// origin of `TL`, the set before it was reordered by `typelist_order`.
+template < typename TL >
+constexpr void _profile_visit( [[maybe_unused]] index_type const i ) noexcept
+{
+#ifdef VARI_PROFILE_VISITS
+        if ( !std::is_constant_evaluated() ) {
+                using key = _profile_key< TL >;
+                _visit_histogram< typename key::type >::record(
+                    i >= TL::size ? i : key::index[i] );
+        }
+#endif
+}
+
+}  // namespace vari
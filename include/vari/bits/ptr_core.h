@@ -23,13 +23,19 @@
 
 #pragma once
 
+#include "vari/bits/assert.h"
 #include "vari/bits/dispatch.h"
+#include "vari/bits/profile.h"
 #include "vari/bits/typelist.h"
 #include "vari/bits/util.h"
 #include "vari/concept.h"
 
+#include <algorithm>
+#include <bit>
 #include <compare>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <utility>
 
 namespace vari
@@ -41,36 +47,193 @@ constexpr void* _to_void_cast( T* p ) noexcept
         return static_cast< void* >( const_cast< std::remove_const_t< T >* >( p ) );
 }
 
+#ifndef VARI_PTR_TAG_MODE
+#define VARI_PTR_TAG_MODE none
+#endif
+
+/// Storage policy for multi-type pointer variadics (`vptr`, `vref`, `uvptr`, `uvref`).
+///
+/// - `none` stores the index and the pointer as separate members.
+/// - `low_bits` packs the index into the bits of the pointer that are zero due to alignment.
+///   Requires all types to be complete at the point where the layout is selected.
+/// - `high_bits` packs the index into the unused upper bits of 64-bit addresses, 7 bits available
+///   on x86-64. Storing a pointer with any of these bits set aborts the program.
+/// - `any` picks `low_bits` if the alignment allows it, `high_bits` otherwise.
+///
+/// In case the selected mode can't be used for given set of types or platform, the layout falls
+/// back to `none`. Tagged layouts can't be used in constant evaluation.
+enum class ptr_tag_mode
+{
+        none,
+        low_bits,
+        high_bits,
+        any
+};
+
+/// Customization point selecting the `ptr_tag_mode` for a flattened typelist `TL`. Defaults to
+/// `VARI_PTR_TAG_MODE` macro, which defaults to `none`.
 template < typename TL >
-struct _ptr_core
+struct ptr_tag_traits
+{
+        static constexpr ptr_tag_mode mode = ptr_tag_mode::VARI_PTR_TAG_MODE;
+};
+
+// Number of upper address bits that are zero in every user-space pointer. x86-64 with 5-level
+// paging (LA57) uses 57-bit addresses, which leaves 7 bits. AArch64 keeps none, as the top byte
+// carries tags under TBI and MTE, and 52-bit addresses use bits below it. `VARI_PTR_HIGH_BITS`
+// overrides the default for platforms with known smaller address space.
+#if defined( VARI_PTR_HIGH_BITS )
+static constexpr std::size_t _ptr_free_high_bits = VARI_PTR_HIGH_BITS;
+#elif defined( __x86_64__ ) || defined( _M_X64 )
+static constexpr std::size_t _ptr_free_high_bits = 7;
+#else
+static constexpr std::size_t _ptr_free_high_bits = 0;
+#endif
+
+static_assert( _ptr_free_high_bits < 64 );
+
+// Called when a pointer does not have free bits the tagged layout relies on. Storing it would
+// lose the bits silently, so it is fatal in all builds.
+[[noreturn]] inline void _ptr_tag_failure() noexcept
 {
+        VARI_ASSERT( false && "pointer has bits used for the tag set" );
+        std::abort();
+}
 
+struct _ptr_plain_storage
+{
         index_type index = null_index;
         void*      ptr   = nullptr;
 
+        [[nodiscard]] constexpr index_type get_index() const noexcept
+        {
+                return index;
+        }
+
+        [[nodiscard]] constexpr void* get_ptr() const noexcept
+        {
+                return ptr;
+        }
+
+        constexpr void set( index_type i, void* p ) noexcept
+        {
+                index = p == nullptr ? null_index : i;
+                ptr   = p;
+        }
+};
+
+/// Packs pointer and index into one word, the index is stored in bits selected by `Mask` starting
+/// at `Shift`. Null pointer is represented by all bits being zero. Bits in the mask are checked to
+/// be zero on each store if `Checked`, which is the case for the upper bits - unlike the low
+/// bits, they are not guaranteed by the type system.
+template < std::size_t Shift, std::uintptr_t Mask, bool Checked = false >
+struct _ptr_tagged_storage
+{
+        std::uintptr_t bits = 0;
+
+        [[nodiscard]] index_type get_index() const noexcept
+        {
+                if ( bits == 0 )
+                        return null_index;
+                return static_cast< index_type >( ( bits & Mask ) >> Shift );
+        }
+
+        [[nodiscard]] void* get_ptr() const noexcept
+        {
+                return reinterpret_cast< void* >( bits & ~Mask );
+        }
+
+        void set( index_type i, void* p ) noexcept
+        {
+                auto raw = reinterpret_cast< std::uintptr_t >( p );
+                if constexpr ( Checked ) {
+                        if ( ( raw & Mask ) != 0 ) [[unlikely]]
+                                _ptr_tag_failure();
+                } else {
+                        VARI_ASSERT( ( raw & Mask ) == 0 );
+                }
+                bits = p == nullptr ? 0 : raw | ( static_cast< std::uintptr_t >( i ) << Shift );
+        }
+};
+
+template < typename TL >
+struct _ptr_storage_select
+{
+        using type = _ptr_plain_storage;
+};
+
+template < typename... Ts >
+        requires(
+            sizeof...( Ts ) > 1 &&
+            ptr_tag_traits< typelist< Ts... > >::mode != ptr_tag_mode::none )
+struct _ptr_storage_select< typelist< Ts... > >
+{
+        static constexpr ptr_tag_mode mode = ptr_tag_traits< typelist< Ts... > >::mode;
+
+        static constexpr std::size_t needed_bits = std::bit_width( sizeof...( Ts ) - 1 );
+
+        static constexpr bool low_fits = [] {
+                if constexpr ( mode == ptr_tag_mode::low_bits || mode == ptr_tag_mode::any )
+                        return std::countr_zero( std::min( { alignof( Ts )... } ) ) >=
+                               static_cast< int >( needed_bits );
+                else
+                        return false;
+        }();
+
+        static constexpr bool high_fits = mode != ptr_tag_mode::low_bits &&
+                                          needed_bits <= _ptr_free_high_bits;
+
+        static constexpr std::size_t    high_shift = 64 - _ptr_free_high_bits;
+        static constexpr std::uintptr_t low_mask   = ( std::uintptr_t{ 1 } << needed_bits ) - 1;
+        static constexpr std::uintptr_t high_mask =
+            high_fits ? ~std::uintptr_t{ 0 } << high_shift : 0;
+
+        using type = std::conditional_t<
+            low_fits,
+            _ptr_tagged_storage< 0, low_mask >,
+            std::conditional_t<
+                high_fits,
+                _ptr_tagged_storage< high_shift, high_mask, true >,
+                _ptr_plain_storage > >;
+};
+
+template < typename TL >
+using _ptr_storage_t = typename _ptr_storage_select< TL >::type;
+
+template < typename TL >
+struct _ptr_core
+{
+        using storage_type = _ptr_storage_t< TL >;
+
+        storage_type storage;
 
         constexpr _ptr_core() noexcept = default;
 
         template < typename UL >
                 requires( vconvertible_to< UL, TL > )
         constexpr _ptr_core( _ptr_core< UL > other ) noexcept
-          : index( _vptr_cnv_map< TL, UL >::conv( other.get_index() ) )
-          , ptr( _to_void_cast( other.ptr ) )
         {
+                storage.set(
+                    _vptr_cnv_map< TL, UL >::conv( other.get_index() ),
+                    _to_void_cast( other.get_ptr() ) );
         }
 
         friend constexpr void swap( _ptr_core& lh, _ptr_core& rh ) noexcept
         {
-                std::swap( lh.ptr, rh.ptr );
-                std::swap( lh.index, rh.index );
+                std::swap( lh.storage, rh.storage );
         }
 
         template < typename U >
                 requires( vconvertible_to< typelist< U >, TL > )
         constexpr void set( U& val ) noexcept
         {
-                index = index_of_t_or_const_t_v< U, TL >;
-                ptr   = _to_void_cast( &val );
+                storage.set( index_of_t_or_const_t_v< U, TL >, _to_void_cast( &val ) );
+        }
+
+        // Sets the core to `p` with index `i` in `TL`, `p` has to point to an object of that type.
+        constexpr void set_raw( index_type i, void* p ) noexcept
+        {
+                storage.set( i, p );
         }
 
         constexpr void reset() noexcept
@@ -80,16 +243,22 @@ struct _ptr_core
 
         [[nodiscard]] constexpr index_type get_index() const noexcept
         {
-                return index;
+                return storage.get_index();
+        }
+
+        [[nodiscard]] constexpr void* get_ptr() const noexcept
+        {
+                return storage.get_ptr();
         }
 
-        template < typename... Fs >
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit_impl( Fs&&... fs ) const
         {
-                return _dispatch_index< 0, TL::size >(
-                    index, [&]< index_type j >() -> decltype( auto ) {
+                _profile_visit< TL >( get_index() );
+                return _dispatch_index< 0, TL::size, S >(
+                    get_index(), [&]< index_type j >() -> decltype( auto ) {
                             using U = type_at_t< j, TL >;
-                            U* p    = static_cast< U* >( ptr );
+                            U* p    = static_cast< U* >( get_ptr() );
                             return _dispatch_fun( *p, (Fs&&) fs... );
                     } );
         }
@@ -98,21 +267,22 @@ struct _ptr_core
         constexpr decltype( auto ) take_impl( Fs&&... fs ) const
         {
                 return _dispatch_index< 0, TL::size >(
-                    index, [&]< index_type j >() -> decltype( auto ) {
+                    get_index(), [&]< index_type j >() -> decltype( auto ) {
                             using U       = type_at_t< j, TL >;
                             using ArgType = ArgTempl< U >;
-                            U* p          = static_cast< U* >( ptr );
+                            U* p          = static_cast< U* >( get_ptr() );
                             return _dispatch_fun( ArgType{ *p }, (Fs&&) fs... );
                     } );
         }
 
         constexpr void delete_ptr( auto&& del )
         {
-                if ( index == null_index )
+                index_type const i = get_index();
+                if ( i == null_index )
                         return;
-                _dispatch_index< 0, TL::size >( index, [&]< index_type j > {
+                _dispatch_index< 0, TL::size >( i, [&]< index_type j > {
                         using U = type_at_t< j, TL >;
-                        del( static_cast< U* >( ptr ) );
+                        del( static_cast< U* >( get_ptr() ) );
                 } );
         }
 };
@@ -149,6 +319,11 @@ struct _ptr_core< typelist< T > >
                 ptr = &val;
         }
 
+        constexpr void set_raw( index_type, void* p ) noexcept
+        {
+                ptr = static_cast< T* >( p );
+        }
+
         constexpr void reset() noexcept
         {
                 *this = _ptr_core{};
@@ -160,7 +335,12 @@ struct _ptr_core< typelist< T > >
                 return ptr == nullptr ? null_index : 0;
         }
 
-        template < typename... Fs >
+        [[nodiscard]] constexpr T* get_ptr() const noexcept
+        {
+                return ptr;
+        }
+
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit_impl( Fs&&... fs ) const
         {
                 return _dispatch_fun( *ptr, (Fs&&) fs... );
@@ -183,13 +363,13 @@ struct _ptr_core< typelist< T > >
 template < typename T >
 constexpr auto operator<=>( _ptr_core< T > const& lh, _ptr_core< T > const& rh ) noexcept
 {
-        return std::compare_three_way{}( lh.ptr, rh.ptr );
+        return std::compare_three_way{}( lh.get_ptr(), rh.get_ptr() );
 }
 
 template < typename T >
 constexpr bool operator==( _ptr_core< T > const& lh, _ptr_core< T > const& rh ) noexcept
 {
-        return lh.ptr == rh.ptr;
+        return lh.get_ptr() == rh.get_ptr();
 }
 
 }  // namespace vari
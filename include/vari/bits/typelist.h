@@ -23,8 +23,11 @@
 
 #pragma once
 
+#include <array>
 #include <concepts>
 #include <cstddef>
+#include <string_view>
+#include <utility>
 
 namespace vari
 {
@@ -90,29 +93,20 @@ struct index_of_t_or_const_t< T, TL > : index_of_t_or_const_t< typelist_traits_t
 {
 };
 
-template < typename T >
-struct index_of_t_or_const_t< T, typelist<> >
-{
-        static_assert( !std::same_as< T, T >, "Type T is not present in the type list" );
-};
-
 template < typename T, typename... Ts >
-struct index_of_t_or_const_t< T, typelist< T, Ts... > >
-{
-        static constexpr std::size_t value = 0;
-};
-
-template < typename T, typename... Ts >
-struct index_of_t_or_const_t< T, typelist< T const, Ts... > >
-{
-        static constexpr std::size_t value = 0;
-};
-
-template < typename T, typename U, typename... Ts >
-struct index_of_t_or_const_t< T, typelist< U, Ts... > >
+struct index_of_t_or_const_t< T, typelist< Ts... > >
 {
-        static constexpr std::size_t value =
-            1 + index_of_t_or_const_t< T, typelist< Ts... > >::value;
+        // Computed out of a flat array of matches instead of recursion over the list, as recursive
+        // instantiations over long lists dominate compilation time of big variadics.
+        static constexpr std::size_t value = [] {
+                constexpr bool matches[sizeof...( Ts ) + 1] = {
+                    ( std::same_as< T, Ts > || std::same_as< T const, Ts > )..., true };
+                std::size_t i = 0;
+                while ( !matches[i] )
+                        ++i;
+                return i;
+        }();
+        static_assert( value != sizeof...( Ts ), "Type T is not present in the type list" );
 };
 
 template < typename T, typename TL >
@@ -132,16 +126,32 @@ struct type_at< j, TL > : type_at< j, typelist_traits_types< TL > >
 {
 };
 
-template < std::size_t j, typename T, typename... Ts >
-struct type_at< j, typelist< T, Ts... > >
+template < std::size_t j, typename T >
+struct _indexed_type
 {
-        using type = typename type_at< j - 1, typelist< Ts... > >::type;
+        using type = T;
 };
 
-template < typename T, typename... Ts >
-struct type_at< 0, typelist< T, Ts... > >
+template < typename Seq, typename... Ts >
+struct _indexed_types;
+
+template < std::size_t... Is, typename... Ts >
+struct _indexed_types< std::index_sequence< Is... >, Ts... > : _indexed_type< Is, Ts >...
 {
-        using type = T;
+};
+
+template < std::size_t j, typename T >
+_indexed_type< j, T > _select_indexed_type( _indexed_type< j, T > const& );
+
+// Selected by overload resolution against base classes of `_indexed_types`, which avoids recursive
+// instantiation over the list. The call is qualified, argument dependent lookup would complete
+// class templates among `Ts...`, which recursive type sets select from while being defined.
+template < std::size_t j, typename... Ts >
+        requires( j < sizeof...( Ts ) )
+struct type_at< j, typelist< Ts... > >
+{
+        using type = typename decltype( vari::_select_indexed_type< j >(
+            std::declval< _indexed_types< std::index_sequence_for< Ts... >, Ts... > >() ) )::type;
 };
 
 template < std::size_t j, typename TL >
@@ -275,6 +285,112 @@ static constexpr bool is_subset_v = is_subset< LH, RH >::value;
 
 // ---
 
+/// Name of type `T` as spelled by the compiler, extracted from the signature of the function.
+template < typename T >
+constexpr std::string_view _type_name() noexcept
+{
+#if defined( __clang__ )
+        std::string_view const s      = __PRETTY_FUNCTION__;
+        std::string_view const prefix = "[T = ";
+        std::string_view const suffix = "]";
+#elif defined( __GNUC__ )
+        std::string_view const s      = __PRETTY_FUNCTION__;
+        std::string_view const prefix = "[with T = ";
+        std::string_view const suffix = "; std::string_view = ";
+#elif defined( _MSC_VER )
+        std::string_view const s      = __FUNCSIG__;
+        std::string_view const prefix = "_type_name<";
+        std::string_view const suffix = ">(void)";
+#endif
+        std::size_t const b = s.find( prefix ) + prefix.size();
+        std::string_view  r = s.substr( b, s.find( suffix, b ) - b );
+        for ( std::string_view const p : { "struct ", "class ", "enum ", "union " } )
+                if ( r.starts_with( p ) )
+                        r.remove_prefix( p.size() );
+        return r;
+}
+
+// Sorts the types by the name spelled by the compiler, types with equal names keep their order.
+template < typename TL >
+struct _canonical_typelist;
+
+template < typename... Ts >
+struct _canonical_typelist< typelist< Ts... > >
+{
+        static constexpr std::array< std::size_t, sizeof...( Ts ) > order = [] {
+                std::array< std::string_view, sizeof...( Ts ) > const names{
+                    _type_name< Ts >()... };
+                std::array< std::size_t, sizeof...( Ts ) > res{};
+                // insertion sort, stable and usable in constant evaluation
+                for ( std::size_t i = 0; i < res.size(); i++ ) {
+                        std::size_t j = i;
+                        for ( ; j > 0 && names[i] < names[res[j - 1]]; j-- )
+                                res[j] = res[j - 1];
+                        res[j] = i;
+                }
+                return res;
+        }();
+
+        template < std::size_t... Is >
+        static typelist< type_at_t< order[Is], typelist< Ts... > >... >
+            sorted( std::index_sequence< Is... > );
+
+        using type = decltype( sorted( std::index_sequence_for< Ts... >{} ) );
+};
+
+#ifdef VARI_CANONICAL_ORDER
+template < typename TL >
+using _canonical_typelist_t = typename _canonical_typelist< TL >::type;
+#else
+template < typename TL >
+using _canonical_typelist_t = TL;
+#endif
+
+/// Customization point for the order of types in variadics. Specializing `typelist_order< TL >`
+/// with `type` aliasing a permutation of `TL` reorders the types of every variadic defined with the
+/// set `TL`, which is the set after flattening and removal of duplicates. Types earlier in the list
+/// get lower indexes and are reached first by the `if_chain` and `binary` dispatch strategies. The
+/// specialization has to be visible to every use of the variadic, ideally it is declared right
+/// after the types, as the variadic is a different type with and without it.
+///
+/// Specializations are generated from a profile of visits by `profile_order.py`, together with
+/// `typelist_origin`.
+///
+/// If `VARI_CANONICAL_ORDER` is defined, sets are first sorted by the names of the types, so that
+/// variadics of the same types in any order are the same type. `typelist_order` is then looked up
+/// with the sorted set. The macro has to be the same in all translation units.
+template < typename TL >
+struct typelist_order
+{
+        using type = TL;
+};
+
+template < typename TL, typename UL = typename typelist_order< _canonical_typelist_t< TL > >::type >
+struct _ordered_typelist
+{
+        static_assert(
+            TL::size == UL::size && is_subset_v< TL, UL > && is_subset_v< UL, TL >,
+            "typelist_order has to alias a permutation of the typelist" );
+
+        using type = UL;
+};
+
+template < typename TL >
+using _ordered_typelist_t = typename _ordered_typelist< TL >::type;
+
+/// Maps set `TL` produced by `typelist_order` back to the set the order was specialized for.
+/// Profiles of visits are keyed by that set, so that profiles collected from a build that already
+/// uses the order produce specializations for the original set again. `profile_order.py` specializes
+/// it next to each generated `typelist_order`. Defaults to the set sorted by names of the types if
+/// `VARI_CANONICAL_ORDER` is defined, which is always the original set, and to `TL` otherwise.
+template < typename TL >
+struct typelist_origin
+{
+        using type = _canonical_typelist_t< TL >;
+};
+
+// ---
+
 // ::value is true if any type in typelist `TL` is const qualified, false otherwise. `TL` has to be
 // `typelist` or typelist compatible type.
 template < typename TL >
@@ -417,6 +533,54 @@ static constexpr bool all_nothrow_copy_constructible_v =
 
 // ---
 
+// ::value is true if all types in typelist `TL` are nothrow copy assignable, false otherwise.
+// `TL` has to be `typelist` or typelist compatible type.
+template < typename TL >
+struct all_nothrow_copy_assignable : _default_template_guard< TL >
+{
+};
+
+template < typelist_compatible TL >
+struct all_nothrow_copy_assignable< TL >
+  : all_nothrow_copy_assignable< typelist_traits_types< TL > >
+{
+};
+
+template < typename... Us >
+struct all_nothrow_copy_assignable< typelist< Us... > >
+{
+        static constexpr bool value = ( std::is_nothrow_copy_assignable_v< Us > && ... && true );
+};
+
+template < typename TL >
+static constexpr bool all_nothrow_copy_assignable_v = all_nothrow_copy_assignable< TL >::value;
+
+// ---
+
+// ::value is true if all types in typelist `TL` are nothrow move assignable, false otherwise.
+// `TL` has to be `typelist` or typelist compatible type.
+template < typename TL >
+struct all_nothrow_move_assignable : _default_template_guard< TL >
+{
+};
+
+template < typelist_compatible TL >
+struct all_nothrow_move_assignable< TL >
+  : all_nothrow_move_assignable< typelist_traits_types< TL > >
+{
+};
+
+template < typename... Us >
+struct all_nothrow_move_assignable< typelist< Us... > >
+{
+        static constexpr bool value = ( std::is_nothrow_move_assignable_v< Us > && ... && true );
+};
+
+template < typename TL >
+static constexpr bool all_nothrow_move_assignable_v = all_nothrow_move_assignable< TL >::value;
+
+// ---
+
 // ::value is true if all types in typelist `TL` are nothrow destructible, false otherwise.
 // `TL` has to be `typelist` or typelist compatible type.
 template < typename TL >
@@ -438,6 +602,129 @@ struct all_nothrow_destructible< typelist< Us... > >
 template < typename TL >
 static constexpr bool all_nothrow_destructible_v = all_nothrow_destructible< TL >::value;
 
+// ---
+
+// ::value is true if all types in typelist `TL` are trivially copy constructible, false otherwise.
+// `TL` has to be `typelist` or typelist compatible type.
+template < typename TL >
+struct all_trivially_copy_constructible : _default_template_guard< TL >
+{
+};
+
+template < typelist_compatible TL >
+struct all_trivially_copy_constructible< TL >
+  : all_trivially_copy_constructible< typelist_traits_types< TL > >
+{
+};
+
+template < typename... Us >
+struct all_trivially_copy_constructible< typelist< Us... > >
+{
+        static constexpr bool value =
+            ( std::is_trivially_copy_constructible_v< Us > && ... && true );
+};
+
+template < typename TL >
+static constexpr bool all_trivially_copy_constructible_v =
+    all_trivially_copy_constructible< TL >::value;
+
+// ---
+
+// ::value is true if all types in typelist `TL` are trivially move constructible, false otherwise.
+// `TL` has to be `typelist` or typelist compatible type.
+template < typename TL >
+struct all_trivially_move_constructible : _default_template_guard< TL >
+{
+};
+
+template < typelist_compatible TL >
+struct all_trivially_move_constructible< TL >
+  : all_trivially_move_constructible< typelist_traits_types< TL > >
+{
+};
+
+template < typename... Us >
+struct all_trivially_move_constructible< typelist< Us... > >
+{
+        static constexpr bool value =
+            ( std::is_trivially_move_constructible_v< Us > && ... && true );
+};
+
+template < typename TL >
+static constexpr bool all_trivially_move_constructible_v =
+    all_trivially_move_constructible< TL >::value;
+
+// ---
+
+// ::value is true if all types in typelist `TL` are trivially copy assignable, false otherwise.
+// `TL` has to be `typelist` or typelist compatible type.
+template < typename TL >
+struct all_trivially_copy_assignable : _default_template_guard< TL >
+{
+};
+
+template < typelist_compatible TL >
+struct all_trivially_copy_assignable< TL >
+  : all_trivially_copy_assignable< typelist_traits_types< TL > >
+{
+};
+
+template < typename... Us >
+struct all_trivially_copy_assignable< typelist< Us... > >
+{
+        static constexpr bool value = ( std::is_trivially_copy_assignable_v< Us > && ... && true );
+};
+
+template < typename TL >
+static constexpr bool all_trivially_copy_assignable_v = all_trivially_copy_assignable< TL >::value;
+
+// ---
+
+// ::value is true if all types in typelist `TL` are trivially move assignable, false otherwise.
+// `TL` has to be `typelist` or typelist compatible type.
+template < typename TL >
+struct all_trivially_move_assignable : _default_template_guard< TL >
+{
+};
+
+template < typelist_compatible TL >
+struct all_trivially_move_assignable< TL >
+  : all_trivially_move_assignable< typelist_traits_types< TL > >
+{
+};
+
+template < typename... Us >
+struct all_trivially_move_assignable< typelist< Us... > >
+{
+        static constexpr bool value = ( std::is_trivially_move_assignable_v< Us > && ... && true );
+};
+
+template < typename TL >
+static constexpr bool all_trivially_move_assignable_v = all_trivially_move_assignable< TL >::value;
+
+// ---
+
+// ::value is true if all types in typelist `TL` are trivially destructible, false otherwise.
+// `TL` has to be `typelist` or typelist compatible type.
+template < typename TL >
+struct all_trivially_destructible : _default_template_guard< TL >
+{
+};
+
+template < typelist_compatible TL >
+struct all_trivially_destructible< TL > : all_trivially_destructible< typelist_traits_types< TL > >
+{
+};
+
+template < typename... Us >
+struct all_trivially_destructible< typelist< Us... > >
+{
+        static constexpr bool value = ( std::is_trivially_destructible_v< Us > && ... && true );
+};
+
+template < typename TL >
+static constexpr bool all_trivially_destructible_v = all_trivially_destructible< TL >::value;
+
 
 // ---
 
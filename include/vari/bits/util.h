@@ -27,7 +27,9 @@
 
 #include <algorithm>
 #include <bit>
+#include <concepts>
 #include <cstdint>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -55,10 +57,11 @@ template < template < typename... > typename T, typename TL, typename... Us >
 using _vptr_apply_t = typename _vptr_apply< T, TL, Us... >::type;
 
 /// Given a templated type `T` and `typelist` of types `TL`, aliases `T<Us...>` where `Us...` is
-/// flattend version of `TL` without any duplicates. If `Extra...` list is provided, it is appended
-/// *before* `Us...`: `T<Extra...,Us...>`
+/// flattend version of `TL` without any duplicates, ordered by `typelist_order`. If `Extra...` list
+/// is provided, it is appended *before* `Us...`: `T<Extra...,Us...>`
 template < template < typename... > typename T, typename TL, typename... Extra >
-using _define_variadic = _vptr_apply_t< T, unique_typelist_t< flatten_t< TL > >, Extra... >;
+using _define_variadic =
+    _vptr_apply_t< T, _ordered_typelist_t< unique_typelist_t< flatten_t< TL > > >, Extra... >;
 
 template < typename F, typename... Args >
 concept invocable = requires( F&& f, Args&&... args ) { ( (F&&) f )( (Args&&) args... ); };
@@ -169,6 +172,41 @@ struct _check_unique_invocability< typelist< Ts... > >
         };
 };
 
+template < typename X, typename Y, typename... Fs >
+concept _invocable_for_one_pair = ( (+invocable< Fs, X, Y >) +... ) == 1;
+
+template < typename F, typename X, typename... Ys >
+concept _invocable_with_any_second = ( invocable< F, X, Ys > || ... || false );
+
+template < typename XL, typename YL >
+struct _check_unique_pair_invocability;
+
+// Same checks as `_check_unique_invocability`, but for callables invoked with pair of arguments,
+// one from `Xs` and one from `Ys`. Each combination has to have exactly one callable.
+template < typename... Xs, typename... Ys >
+struct _check_unique_pair_invocability< typelist< Xs... >, typelist< Ys... > >
+{
+        template < typename X, typename... Fs >
+        static constexpr bool row_unique =
+            ( _invocable_for_one_pair< X, Ys, Fs... > && ... );
+
+        template < typename F >
+        static constexpr bool used =
+            ( _invocable_with_any_second< F, Xs, Ys... > || ... || false );
+
+        template < typename... Fs >
+        struct with
+        {
+                static_assert(
+                    ( row_unique< Xs, Fs... > && ... ),
+                    "For each combination of types, there has to be one and only one callable" );
+                static_assert(
+                    ( used< Fs > && ... ),
+                    "For each function, there has to be at least one combination of types it is "
+                    "invocable with" );
+        };
+};
+
 template < typename... Args >
 struct _function_picker
 {
@@ -187,15 +225,32 @@ struct _function_picker
 using index_type                 = uint32_t;
 static constexpr auto null_index = std::numeric_limits< index_type >::max();
 
+/// Smallest unsigned integer type able to store index of any out of `N` types and null value.
+/// Null value is represented by maximum of the type, which is what `null_index` truncates to.
+template < std::size_t N >
+using _index_storage_t = std::conditional_t<
+    ( N <= std::numeric_limits< uint8_t >::max() ),
+    uint8_t,
+    std::conditional_t< ( N <= std::numeric_limits< uint16_t >::max() ), uint16_t, index_type > >;
+
 template < typename TL, typename UL >
 struct _vptr_cnv_map;
 
 template < typename TL, typename... Us >
 struct _vptr_cnv_map< TL, typelist< Us... > >
 {
+        // `Us...` is a prefix of `TL`, each index maps to itself and so does the null index
+        static constexpr bool identity = [] {
+                std::size_t j = 0;
+                return ( ( index_of_t_or_const_t_v< Us, TL > == j++ ) && ... );
+        }();
+
         static constexpr index_type conv( std::size_t i )
         {
-                return i == null_index ? null_index : value[i];
+                if constexpr ( identity )
+                        return static_cast< index_type >( i );
+                else
+                        return i == null_index ? null_index : value[i];
         }
 
 private:
@@ -233,6 +288,37 @@ struct _split_impl< typelist<>, typelist<> >
 template < typename TL >
 using split = _split_impl< typelist<>, TL >;
 
+// Splits typelist `TL` into consecutive typelists of `N` types, the last one might be shorter.
+// `Done` collects the finished chunks and `Cur` the chunk being filled.
+template < std::size_t N, typename Done, typename Cur, typename TL >
+struct _chunk_impl;
+
+template < std::size_t N, typename... Ds, typename... Cs >
+struct _chunk_impl< N, typelist< Ds... >, typelist< Cs... >, typelist<> >
+{
+        using type = std::conditional_t<
+            sizeof...( Cs ) == 0,
+            typelist< Ds... >,
+            typelist< Ds..., typelist< Cs... > > >;
+};
+
+template < std::size_t N, typename... Ds, typename... Cs, typename T, typename... Ts >
+        requires( sizeof...( Cs ) + 1 < N )
+struct _chunk_impl< N, typelist< Ds... >, typelist< Cs... >, typelist< T, Ts... > >
+  : _chunk_impl< N, typelist< Ds... >, typelist< Cs..., T >, typelist< Ts... > >
+{
+};
+
+template < std::size_t N, typename... Ds, typename... Cs, typename T, typename... Ts >
+        requires( sizeof...( Cs ) + 1 == N )
+struct _chunk_impl< N, typelist< Ds... >, typelist< Cs... >, typelist< T, Ts... > >
+  : _chunk_impl< N, typelist< Ds..., typelist< Cs..., T > >, typelist<>, typelist< Ts... > >
+{
+};
+
+template < std::size_t N, typename TL >
+using chunk_t = typename _chunk_impl< N, typelist<>, typelist<>, TL >::type;
+
 template < typename Deleter >
 struct _deleter_box;
 
@@ -290,6 +376,18 @@ private:
         Deleter* _del_ref;
 };
 
+template < typename T >
+concept _std_hashable = requires( T const& v ) {
+        { std::hash< T >{}( v ) } -> std::convertible_to< std::size_t >;
+};
+
+/// Mixes `v` into `seed`, the step of `boost::hash_combine`.
+constexpr std::size_t _hash_combine( std::size_t seed, std::size_t v ) noexcept
+{
+        return seed ^ ( v + static_cast< std::size_t >( 0x9e3779b97f4a7c15ull ) + ( seed << 6 ) +
+                        ( seed >> 2 ) );
+}
+
 template < std::size_t Align >
 constexpr std::intptr_t hash_ptr( void* p )
 {
@@ -23,13 +23,21 @@
 
 #pragma once
 
+#include "../bytewise.h"
 #include "../concept.h"
+#include "../niche.h"
+#include "../relocate.h"
 #include "./dispatch.h"
+#include "./profile.h"
 #include "./util.h"
 #include "./val_union.h"
 
 #include <compare>
+#include <cstddef>
+#include <cstring>
+#include <limits>
 #include <memory>
+#include <utility>
 
 namespace vari
 {
@@ -37,12 +45,73 @@ namespace vari
 template < typename TL >
 struct _val_core
 {
-        using ST = _val_union< TL >;
+        using ST    = _val_union< TL >;
+        using niche = _val_niche< TL >;
 
-        index_type index = null_index;
-        ST         storage;
+        static constexpr bool is_niche = niche::enabled;
 
-        constexpr _val_core() noexcept = default;
+        // Values of relocatable types are moved between storages by copying the bytes of the storage
+        // and the tag, without dispatching on the index.
+        static constexpr bool trivially_relocatable = _all_trivially_relocatable_v< TL >;
+
+        using tag_type = std::conditional_t< is_niche, empty_t, _index_storage_t< TL::size > >;
+
+        static constexpr tag_type null_tag = [] {
+                if constexpr ( is_niche )
+                        return tag_type{};
+                else
+                        return std::numeric_limits< tag_type >::max();
+        }();
+
+        // Tag is placed after the storage, so the storage starts at offset zero without padding in
+        // front of it. The tag does not reuse tail padding of the items: the union covers the
+        // whole size of its largest item, so the tag always adds its own size rounded up to the
+        // alignment of the storage, `vval< struct{ int; char }, char >` takes 12 bytes. With niche
+        // layout, the index is encoded in the storage itself and the tag is empty.
+        ST                             storage;
+        [[no_unique_address]] tag_type tag = null_tag;
+
+        [[nodiscard]] constexpr index_type get_index() const noexcept
+        {
+                if constexpr ( is_niche )
+                        return niche::get( &storage );
+                else
+                        return tag == null_tag ? null_index : tag;
+        }
+
+        // Has to be called after the object of type `i` is constructed in the storage.
+        constexpr void set_index( index_type i ) noexcept
+        {
+                if constexpr ( is_niche )
+                        niche::set( &storage, i );
+                else
+                        tag = static_cast< tag_type >( i );
+        }
+
+        constexpr _val_core() noexcept
+                requires( !is_niche )
+        = default;
+
+        _val_core() noexcept
+                requires( is_niche )
+        {
+                set_index( null_index );
+        }
+
+        // Each special member has a defaulted overload that is selected whenever all the types are
+        // trivial for the operation, which makes the core itself trivially copyable, movable or
+        // destructible. Both the storage and the tag are then copied bytewise, which is what the
+        // non-trivial overloads would do anyway.
+        static constexpr bool trivially_copy_assignable =
+            all_trivially_copy_constructible_v< TL > && all_trivially_copy_assignable_v< TL > &&
+            all_trivially_destructible_v< TL >;
+        static constexpr bool trivially_move_assignable =
+            all_trivially_move_constructible_v< TL > && all_trivially_move_assignable_v< TL > &&
+            all_trivially_destructible_v< TL >;
+
+        constexpr _val_core( _val_core const& other )
+                requires( all_trivially_copy_constructible_v< TL > )
+        = default;
 
         constexpr _val_core( _val_core const& other ) noexcept(
             all_nothrow_copy_constructible_v< TL > )
@@ -58,6 +127,10 @@ struct _val_core
                 _copy_or_move_construct< false, UL >( *this, other );
         }
 
+        constexpr _val_core( _val_core&& other )
+                requires( all_trivially_move_constructible_v< TL > )
+        = default;
+
         constexpr _val_core( _val_core&& other ) noexcept( all_nothrow_move_constructible_v< TL > )
         {
                 _copy_or_move_construct< true, TL >( *this, other );
@@ -71,95 +144,318 @@ struct _val_core
                 _copy_or_move_construct< true, UL >( *this, other );
         }
 
+        // Storage of `_val_core< UL >` can be copied bytewise into this storage: all types of both
+        // unions live at their start, only the index has to be mapped. Niche layouts keep the
+        // index in the bytes of the storage and are excluded.
+        template < typename UL >
+        static constexpr bool _bytewise_from =
+            !is_niche && !_val_core< UL >::is_niche &&
+            sizeof( typename _val_core< UL >::ST ) <= sizeof( ST );
+
+        template < typename UL >
+        void _copy_bytes_from( _val_core< UL > const& other ) noexcept
+        {
+                std::memcpy(
+                    static_cast< void* >( &storage ),
+                    static_cast< void const* >( &other.storage ),
+                    sizeof( other.storage ) );
+                set_index( _vptr_cnv_map< TL, UL >::conv( other.get_index() ) );
+        }
+
         template < bool IS_MOVE, typename UL >
         static constexpr void _copy_or_move_construct( auto& self, auto& other ) noexcept(
             IS_MOVE ? all_nothrow_move_constructible_v< UL > :
                       all_nothrow_copy_constructible_v< UL > )
         {
-                if ( other.index == null_index )
+                if constexpr ( _bytewise_from< UL > && _all_trivially_copyable_v< UL > ) {
+                        if ( !std::is_constant_evaluated() ) {
+                                self._copy_bytes_from( other );
+                                return;
+                        }
+                }
+                index_type const oi = other.get_index();
+                if ( oi == null_index ) {
+                        if constexpr ( is_niche )
+                                self.set_index( null_index );
                         return;
-                _dispatch_index< 0, UL::size >(
-                    other.index, [&]< index_type j >() -> decltype( auto ) {
-                            static constexpr index_type i = _vptr_cnv_map< TL, UL >::conv( j );
-                            using OST                     = typename _val_core< UL >::ST;
-
-                            self.index = i;
-                            if constexpr ( IS_MOVE )
-                                    std::construct_at(
-                                        &ST::template get< i >( self.storage ),
-                                        std::move( OST::template get< j >( other.storage ) ) );
-                            else
-                                    std::construct_at(
-                                        &ST::template get< i >( self.storage ),
-                                        OST::template get< j >( other.storage ) );
-                    } );
+                }
+                _dispatch_index< 0, UL::size >( oi, [&]< index_type j >() -> decltype( auto ) {
+                        constexpr index_type i = _vptr_cnv_map< TL, UL >::conv( j );
+                        using OST              = typename _val_core< UL >::ST;
+
+                        if constexpr ( IS_MOVE )
+                                std::construct_at(
+                                    &ST::template get< i >( self.storage ),
+                                    std::move( OST::template get< j >( other.storage ) ) );
+                        else
+                                std::construct_at(
+                                    &ST::template get< i >( self.storage ),
+                                    OST::template get< j >( other.storage ) );
+                        self.set_index( i );
+                } );
+        }
+
+        // Relocates the value of `other` into this core, which has to be empty. `other` is left
+        // empty. Trivially relocatable values are moved as bytes of the storage together with the
+        // index, others are move constructed and the source is destroyed.
+        template < typename UL >
+        static constexpr bool nothrow_relocatable_from =
+            ( _bytewise_from< UL > && _all_trivially_relocatable_v< UL > ) ||
+            ( all_nothrow_move_constructible_v< UL > && all_nothrow_destructible_v< UL > );
+
+        template < typename UL >
+        constexpr void
+        relocate_from( _val_core< UL >& other ) noexcept( nothrow_relocatable_from< UL > )
+        {
+                if constexpr ( _bytewise_from< UL > && _all_trivially_relocatable_v< UL > ) {
+                        if ( !std::is_constant_evaluated() ) {
+                                _copy_bytes_from( other );
+                                other.set_index( null_index );
+                                return;
+                        }
+                }
+                index_type const oi = other.get_index();
+                if ( oi == null_index )
+                        return;
+                _dispatch_index< 0, UL::size >( oi, [&]< index_type j > {
+                        constexpr index_type i = _vptr_cnv_map< TL, UL >::conv( j );
+                        using OST              = typename _val_core< UL >::ST;
+
+                        auto& src = OST::template get< j >( other.storage );
+                        std::construct_at( &ST::template get< i >( storage ), std::move( src ) );
+                        set_index( i );
+                        std::destroy_at( &src );
+                } );
+                other.set_index( null_index );
         }
 
         template < typename O >
         static constexpr bool is_nothrow_assignable =
-            noexcept( _val_core{ std::declval< O >() } ) &&
-            std::is_nothrow_swappable_v< _val_core >;
+            noexcept( std::declval< _val_core& >().assign( std::declval< O >() ) );
+
+        // Alternative in which value of type `T` is stored, might be `T const`
+        template < typename T >
+        using _stored_t = type_at_t< index_of_t_or_const_t_v< T, TL >, TL >;
+
+        template < typename T, typename U >
+        static constexpr bool is_nothrow_value_assignable =
+            std::is_nothrow_constructible_v< T, U > &&
+            ( !std::is_assignable_v< _stored_t< T >&, U > ||
+              std::is_nothrow_assignable_v< _stored_t< T >&, U > ) &&
+            all_nothrow_destructible_v< TL >;
+
+        // Assigns `v` as value of type `T`. If `T` is already stored, its assignment operator is
+        // used in place, which keeps any resources of the current value (capacity of strings or
+        // vectors). Otherwise, or if the stored alternative is `T const`, the current value is
+        // destroyed and `T` is constructed from `v` directly, or, if that may throw, in a temporary
+        // first - so the current value is not lost.
+        template < typename T, typename U >
+        constexpr void assign_value( U&& v ) noexcept( is_nothrow_value_assignable< T, U > )
+        {
+                constexpr index_type i = index_of_t_or_const_t_v< T, TL >;
+
+                if constexpr ( std::is_assignable_v< _stored_t< T >&, U > ) {
+                        if ( get_index() == i ) {
+                                ST::template get< i >( storage ) = (U&&) v;
+                                return;
+                        }
+                }
+
+                if constexpr ( std::is_nothrow_constructible_v< T, U > ) {
+                        if ( get_index() != null_index )
+                                destroy();
+                        emplace< T >( (U&&) v );
+                } else {
+                        assign_value_strong< T >( (U&&) v );
+                }
+        }
+
+        // Assigns `v` as value of type `T` with strong exception guarantee, as long as move
+        // constructors do not throw. The new value is always constructed in a temporary first.
+        template < typename T, typename U >
+        constexpr void assign_value_strong( U&& v ) noexcept(
+            std::is_nothrow_constructible_v< T, U > && all_nothrow_move_constructible_v< TL > &&
+            all_nothrow_destructible_v< TL > )
+        {
+                _val_core tmp;
+                tmp.template emplace< T >( (U&&) v );
+                _replace_with( tmp );
+        }
+
+        template < typename UL >
+        constexpr void assign( _val_core< UL > const& other ) noexcept(
+            all_nothrow_copy_constructible_v< UL > && all_nothrow_copy_assignable_v< UL > &&
+            all_nothrow_destructible_v< TL > )
+        {
+                _assign< false, UL >( other );
+        }
 
+        template < typename UL >
+        constexpr void assign( _val_core< UL >&& other ) noexcept(
+            all_nothrow_move_constructible_v< UL > && all_nothrow_move_assignable_v< UL > &&
+            all_nothrow_destructible_v< TL > )
+        {
+                _assign< true, UL >( other );
+        }
+
+        template < bool IS_MOVE, typename UL >
+        constexpr void _assign( auto& other )
+        {
+                index_type const oi = other.get_index();
+                if ( oi == null_index ) {
+                        if ( get_index() != null_index )
+                                destroy();
+                        return;
+                }
+                _dispatch_index< 0, UL::size >( oi, [&]< index_type j > {
+                        constexpr index_type i = _vptr_cnv_map< TL, UL >::conv( j );
+                        using OST              = typename _val_core< UL >::ST;
+                        using T                = type_at_t< i, TL >;
+
+                        if constexpr ( IS_MOVE )
+                                assign_value< T >(
+                                    std::move( OST::template get< j >( other.storage ) ) );
+                        else
+                                assign_value< T >( OST::template get< j >( other.storage ) );
+                } );
+        }
+
+        // Assigns value of `other` with strong exception guarantee, as long as move constructors do
+        // not throw.
         template < typename O >
-        constexpr void assign( O&& other ) noexcept( is_nothrow_assignable< O > )
+        constexpr void assign_strong( O&& other ) noexcept(
+            noexcept( _val_core{ std::declval< O >() } ) &&
+            all_nothrow_move_constructible_v< TL > && all_nothrow_destructible_v< TL > )
         {
                 _val_core tmp{ (O&&) other };
-                swap( *this, tmp );
+                _replace_with( tmp );
+        }
+
+        constexpr void _replace_with( _val_core& tmp ) noexcept(
+            all_nothrow_move_constructible_v< TL > && all_nothrow_destructible_v< TL > )
+        {
+                if ( get_index() != null_index )
+                        destroy();
+                if ( tmp.get_index() != null_index )
+                        move_from_to( tmp, *this );
+        }
+
+        constexpr _val_core& operator=( _val_core const& other )
+                requires( trivially_copy_assignable )
+        = default;
+
+        constexpr _val_core&
+        operator=( _val_core const& other ) noexcept( is_nothrow_assignable< _val_core const& > )
+        {
+                assign( other );
+                return *this;
+        }
+
+        constexpr _val_core& operator=( _val_core&& other )
+                requires( trivially_move_assignable )
+        = default;
+
+        constexpr _val_core&
+        operator=( _val_core&& other ) noexcept( is_nothrow_assignable< _val_core&& > )
+        {
+                assign( std::move( other ) );
+                return *this;
+        }
+
+        constexpr ~_val_core()
+                requires( all_trivially_destructible_v< TL > )
+        = default;
+
+        constexpr ~_val_core() noexcept( all_nothrow_destructible_v< TL > )
+        {
+                if ( get_index() != null_index )
+                        destroy();
         }
 
         friend constexpr void swap( _val_core& lh, _val_core& rh ) noexcept(
             all_nothrow_swappable_v< TL > && all_nothrow_move_constructible_v< TL > &&
             all_nothrow_destructible_v< TL > )
         {
-                if ( lh.index == rh.index )
-                        return _dispatch_index< 0, TL::size >(
-                            lh.index, [&]< index_type j >() -> decltype( auto ) {
-                                    auto& l = ST::template get< j >( lh.storage );
-                                    auto& r = ST::template get< j >( rh.storage );
-                                    using namespace std;
-                                    swap( l, r );
-                            } );
+                index_type const li = lh.get_index();
+                if ( li == rh.get_index() ) {
+                        if ( li == null_index )
+                                return;
+                        return _dispatch_index< 0, TL::size >( li, [&]< index_type j > {
+                                auto& l = ST::template get< j >( lh.storage );
+                                auto& r = ST::template get< j >( rh.storage );
+                                using namespace std;
+                                swap( l, r );
+                        } );
+                }
+
+                if constexpr ( trivially_relocatable ) {
+                        if ( !std::is_constant_evaluated() ) {
+                                alignas( ST ) std::byte tmp[sizeof( ST )];
+                                std::memcpy( tmp, &lh.storage, sizeof( ST ) );
+                                std::memcpy(
+                                    static_cast< void* >( &lh.storage ),
+                                    static_cast< void const* >( &rh.storage ),
+                                    sizeof( ST ) );
+                                std::memcpy( static_cast< void* >( &rh.storage ), tmp, sizeof( ST ) );
+                                std::swap( lh.tag, rh.tag );
+                                return;
+                        }
+                }
 
                 _val_core tmp{ std::move( lh ) };
-                if ( lh.index != null_index )
+                if ( li != null_index )
                         lh.destroy();
 
-                if ( rh.index != null_index )
+                if ( rh.get_index() != null_index )
                         move_from_to( rh, lh );
 
-                if ( tmp.index != null_index )
+                if ( tmp.get_index() != null_index )
                         move_from_to( tmp, rh );
         }
 
         friend constexpr void move_from_to( _val_core& lh, _val_core& rh ) noexcept(
             all_nothrow_move_constructible_v< TL > && all_nothrow_destructible_v< TL > )
         {
+                if constexpr ( trivially_relocatable ) {
+                        if ( !std::is_constant_evaluated() ) {
+                                std::memcpy(
+                                    static_cast< void* >( &rh.storage ),
+                                    static_cast< void const* >( &lh.storage ),
+                                    sizeof( ST ) );
+                                rh.tag = lh.tag;
+                                lh.set_index( null_index );
+                                return;
+                        }
+                }
                 _dispatch_index< 0, TL::size >(
-                    lh.index, [&]< index_type j >() -> decltype( auto ) {
+                    lh.get_index(), [&]< index_type j >() -> decltype( auto ) {
                             auto& l = ST::template get< j >( lh.storage );
                             auto& r = ST::template get< j >( rh.storage );
                             std::construct_at( &r, std::move( l ) );
-                            rh.index = lh.index;
+                            rh.set_index( j );
                             std::destroy_at( &l );
+                            lh.set_index( null_index );
                     } );
         }
 
 
-        template < typename... Fs >
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         static constexpr decltype( auto ) visit_impl( auto& self, Fs&&... fs )
         {
-                return _dispatch_index< 0, TL::size >(
-                    self.index, [&]< index_type j >() -> decltype( auto ) {
+                _profile_visit< TL >( self.get_index() );
+                return _dispatch_index< 0, TL::size, S >(
+                    self.get_index(), [&]< index_type j >() -> decltype( auto ) {
                             auto& p = ST::template get< j >( self.storage );
                             return _dispatch_fun( p, (Fs&&) fs... );
                     } );
         }
 
-        template < typename F >
+        template < dispatch_strategy S = default_dispatch_strategy, typename F >
         static constexpr decltype( auto ) visit_impl( auto& self, F&& f )
         {
-                return _dispatch_index< 0, TL::size >(
-                    self.index, [&]< index_type j >() -> decltype( auto ) {
+                _profile_visit< TL >( self.get_index() );
+                return _dispatch_index< 0, TL::size, S >(
+                    self.get_index(), [&]< index_type j >() -> decltype( auto ) {
                             auto& p = ST::template get< j >( self.storage );
 
                             return ( (F&&) f )( p );
@@ -172,16 +468,17 @@ struct _val_core
         {
                 constexpr index_type i = index_of_t_or_const_t_v< T, TL >;
 
-                index = i;
-                return *std::construct_at( &ST::template get< i >( storage ), (Args&&) args... );
+                auto& res = *std::construct_at( &ST::template get< i >( storage ), (Args&&) args... );
+                set_index( i );
+                return res;
         }
 
         constexpr void destroy() noexcept( all_nothrow_destructible_v< TL > )
         {
-                _dispatch_index< 0, TL::size >( index, [&]< index_type j > {
+                _dispatch_index< 0, TL::size >( get_index(), [&]< index_type j > {
                         std::destroy_at( &ST::template get< j >( storage ) );
                 } );
-                index = null_index;
+                set_index( null_index );
         }
 
         // XXX: this needs serious tests
@@ -192,8 +489,8 @@ struct _val_core
         {
                 // XXX: the partial ordering thing might be improved
 
-                index_type lh_i = lh.index;
-                index_type rh_i = rh.index;
+                index_type lh_i = lh.get_index();
+                index_type rh_i = rh.get_index();
                 if ( lh_i != rh_i )
                         return lh_i <=> rh_i;
                 return _dispatch_index< 0, TL::size >(
@@ -203,17 +500,57 @@ struct _val_core
                     } );
         }
 
+        // Hash of value `v` stored at index `i`, the index is mixed in so that equal values of
+        // different types differ.
+        template < typename T >
+        static std::size_t hash_item( index_type i, T const& v )
+        {
+                if constexpr ( is_bytewise_comparable_v< std::remove_const_t< T > > )
+                        return _hash_combine( _hash_bytes( &v, sizeof( T ) ), i );
+                else
+                        return _hash_combine( std::hash< std::remove_const_t< T > >{}( v ), i );
+        }
+
+        static std::size_t hash( _val_core const& c )
+        {
+                index_type const i = c.get_index();
+                if ( i == null_index )
+                        return _hash_combine( 0, i );
+                // All items are at the start of the storage, only their size differs
+                if constexpr ( _all_bytewise_comparable_v< TL > )
+                        return _hash_combine(
+                            _hash_bytes( &c.storage, _item_sizes< TL >::value[i] ), i );
+                else
+                        return _dispatch_index< 0, TL::size >( i, [&]< index_type j > {
+                                return hash_item( j, ST::template get< j >( c.storage ) );
+                        } );
+        }
+
         static constexpr decltype( auto ) compare(
             _val_core const& lh,
             _val_core const& rh ) noexcept( all_nothrow_equality_comparable_v< TL > )
         {
-                index_type lh_i = lh.index;
-                index_type rh_i = rh.index;
+                index_type lh_i = lh.get_index();
+                index_type rh_i = rh.get_index();
                 if ( lh_i != rh_i )
                         return lh_i == rh_i;
-                return _dispatch_index< 0, TL::size >( lh_i, [&]< index_type j > {
-                        return ST::template get< j >( lh.storage ) ==
-                               ST::template get< j >( rh.storage );
+                // Empty after being moved from, there is no item to compare
+                if ( lh_i == null_index )
+                        return true;
+                if constexpr ( _all_bytewise_comparable_v< TL > ) {
+                        if ( !std::is_constant_evaluated() )
+                                return _equal_bytes(
+                                    &lh.storage, &rh.storage, _item_sizes< TL >::value[lh_i] );
+                }
+                return _dispatch_index< 0, TL::size >( lh_i, [&]< index_type j >() -> bool {
+                        auto& l = ST::template get< j >( lh.storage );
+                        auto& r = ST::template get< j >( rh.storage );
+                        using T = std::remove_cvref_t< decltype( l ) >;
+                        if constexpr ( is_bytewise_comparable_v< T > ) {
+                                if ( !std::is_constant_evaluated() )
+                                        return _equal_bytes( &l, &r, sizeof( T ) );
+                        }
+                        return l == r;
                 } );
         }
 };
@@ -39,39 +39,68 @@ union _val_union
             "val_union<T> created with unacceptable type - only typelist is allowed" );
 };
 
+// All unions have `null_item` member that is active after default construction, so storage without
+// any value is still usable in constant expressions. It has its own type, so that it does not
+// collide with other empty members of the same type placed over the union.
+struct _val_union_null
+{
+};
+
+// Destructor of the union can be defaulted only if all alternatives are trivially destructible,
+// otherwise it has to be user-provided.
+template < typename U >
+static constexpr bool _val_union_trivially_destructible = false;
+
+template < typename TL >
+static constexpr bool _val_union_trivially_destructible< _val_union< TL > > =
+    all_trivially_destructible_v< TL >;
+
+/// Number of types up to which `_val_union` is a flat union with one member per type. Has to match
+/// the `--limit` used to generate the specializations by `val_union.py`.
+static constexpr index_type _val_union_flat_limit = 32;
+
+template < typename TL >
+struct _val_union_boxes;
+
+template < typename... TLs >
+struct _val_union_boxes< typelist< TLs... > >
+{
+        using type = typelist< _val_union< TLs >... >;
+};
+
+// Types beyond the flat limit are split into chunks of `_val_union_flat_limit` types, each chunk is
+// stored in flat union and all chunks are members of another flat union. Access to any type is
+// therefore two non-recursive lookups for up to `_val_union_flat_limit` squared types.
 template < typename... Ts >
 union _val_union< typelist< Ts... > >
 {
         static constexpr index_type size = sizeof...( Ts );
 
-        _val_union() noexcept {};
-        ~_val_union(){};
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
 
-        using s1 = split< typelist< Ts... > >;
-        using s2 = split< typename s1::lh >;
-        using s3 = split< typename s1::rh >;
+        static constexpr index_type L = _val_union_flat_limit;
 
-        using b0 = _val_union< typename s2::lh >;
-        using b1 = _val_union< typename s2::rh >;
-        using b2 = _val_union< typename s3::lh >;
-        using b3 = _val_union< typename s3::rh >;
+        using boxes_types = typename _val_union_boxes<
+            chunk_t< _val_union_flat_limit, typelist< Ts... > > >::type;
+        using boxes_union = _val_union< boxes_types >;
 
-        b0 box0;
-        b1 box1;
-        b2 box2;
-        b3 box3;
+        _val_union_null null_item;
+        boxes_union     boxes;
 
         template < index_type i >
         constexpr static auto& get( auto& s )
         {
-                if constexpr ( i < b0::size )
-                        return b0::template get< i >( s.box0 );
-                else if constexpr ( i < b0::size + b1::size )
-                        return b1::template get< i - b0::size >( s.box1 );
-                else if constexpr ( i < b0::size + b1::size + b2::size )
-                        return b2::template get< i - b0::size - b1::size >( s.box2 );
-                else if constexpr ( i < b0::size + b1::size + b2::size + b3::size )
-                        return b3::template get< i - b0::size - b1::size - b2::size >( s.box3 );
+                using box = type_at_t< i / L, boxes_types >;
+                return box::template get< i % L >( boxes_union::template get< i / L >( s.boxes ) );
         }
 };
 
@@ -80,13 +109,13 @@ union _val_union< typelist<> >
 {
         static constexpr index_type size = 0;
 
-        _val_union() noexcept
-        {
-        }
-        ~_val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
 
+        _val_union_null null_item;
+
         template < index_type i >
         constexpr static auto& get( auto& s )
         {
@@ -101,13 +130,19 @@ union _val_union< typelist< T0 > >
 {
         static constexpr index_type size = 1;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
 
 
@@ -125,13 +160,19 @@ union _val_union< typelist< T0, T1 > >
 {
         static constexpr index_type size = 2;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
 
@@ -152,13 +193,19 @@ union _val_union< typelist< T0, T1, T2 > >
 {
         static constexpr index_type size = 3;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
         T2 item2;
@@ -182,13 +229,19 @@ union _val_union< typelist< T0, T1, T2, T3 > >
 {
         static constexpr index_type size = 4;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
         T2 item2;
@@ -215,13 +268,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4 > >
 {
         static constexpr index_type size = 5;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
         T2 item2;
@@ -251,13 +310,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5 > >
 {
         static constexpr index_type size = 6;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
         T2 item2;
@@ -297,13 +362,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6 > >
 {
         static constexpr index_type size = 7;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
         T2 item2;
@@ -347,13 +418,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7 > >
 {
         static constexpr index_type size = 8;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
         T2 item2;
@@ -401,13 +478,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8 > >
 {
         static constexpr index_type size = 9;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
         T2 item2;
@@ -459,13 +542,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9 > >
 {
         static constexpr index_type size = 10;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0 item0;
         T1 item1;
         T2 item2;
@@ -521,13 +610,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10 > >
 {
         static constexpr index_type size = 11;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0  item0;
         T1  item1;
         T2  item2;
@@ -587,13 +682,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11 > >
 {
         static constexpr index_type size = 12;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0  item0;
         T1  item1;
         T2  item2;
@@ -657,13 +758,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T1
 {
         static constexpr index_type size = 13;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0  item0;
         T1  item1;
         T2  item2;
@@ -731,13 +838,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T1
 {
         static constexpr index_type size = 14;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0  item0;
         T1  item1;
         T2  item2;
@@ -809,13 +922,19 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T1
 {
         static constexpr index_type size = 15;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
         {
         }
 
+        _val_union_null null_item;
+
         T0  item0;
         T1  item1;
         T2  item2;
@@ -891,12 +1010,2362 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T1
 {
         static constexpr index_type size = 16;
 
-        _val_union() noexcept
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16 > >
+{
+        static constexpr index_type size = 17;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17 > >
+{
+        static constexpr index_type size = 18;
+
+        constexpr _val_union() noexcept
+          : null_item()
         {
         }
-        ~_val_union() noexcept
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
         {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
         }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18 > >
+{
+        static constexpr index_type size = 19;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19 > >
+{
+        static constexpr index_type size = 20;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20 > >
+{
+        static constexpr index_type size = 21;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21 > >
+{
+        static constexpr index_type size = 22;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22 > >
+{
+        static constexpr index_type size = 23;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23 > >
+{
+        static constexpr index_type size = 24;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23,
+    typename T24 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23,
+    T24 > >
+{
+        static constexpr index_type size = 25;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+        T24 item24;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+                if constexpr ( i == 24 )
+                        return s.item24;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23,
+    typename T24,
+    typename T25 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23,
+    T24,
+    T25 > >
+{
+        static constexpr index_type size = 26;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+        T24 item24;
+        T25 item25;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+                if constexpr ( i == 24 )
+                        return s.item24;
+                if constexpr ( i == 25 )
+                        return s.item25;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23,
+    typename T24,
+    typename T25,
+    typename T26 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23,
+    T24,
+    T25,
+    T26 > >
+{
+        static constexpr index_type size = 27;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+        T24 item24;
+        T25 item25;
+        T26 item26;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+                if constexpr ( i == 24 )
+                        return s.item24;
+                if constexpr ( i == 25 )
+                        return s.item25;
+                if constexpr ( i == 26 )
+                        return s.item26;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23,
+    typename T24,
+    typename T25,
+    typename T26,
+    typename T27 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23,
+    T24,
+    T25,
+    T26,
+    T27 > >
+{
+        static constexpr index_type size = 28;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+        T24 item24;
+        T25 item25;
+        T26 item26;
+        T27 item27;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+                if constexpr ( i == 24 )
+                        return s.item24;
+                if constexpr ( i == 25 )
+                        return s.item25;
+                if constexpr ( i == 26 )
+                        return s.item26;
+                if constexpr ( i == 27 )
+                        return s.item27;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23,
+    typename T24,
+    typename T25,
+    typename T26,
+    typename T27,
+    typename T28 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23,
+    T24,
+    T25,
+    T26,
+    T27,
+    T28 > >
+{
+        static constexpr index_type size = 29;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+        T24 item24;
+        T25 item25;
+        T26 item26;
+        T27 item27;
+        T28 item28;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+                if constexpr ( i == 24 )
+                        return s.item24;
+                if constexpr ( i == 25 )
+                        return s.item25;
+                if constexpr ( i == 26 )
+                        return s.item26;
+                if constexpr ( i == 27 )
+                        return s.item27;
+                if constexpr ( i == 28 )
+                        return s.item28;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23,
+    typename T24,
+    typename T25,
+    typename T26,
+    typename T27,
+    typename T28,
+    typename T29 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23,
+    T24,
+    T25,
+    T26,
+    T27,
+    T28,
+    T29 > >
+{
+        static constexpr index_type size = 30;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+        T24 item24;
+        T25 item25;
+        T26 item26;
+        T27 item27;
+        T28 item28;
+        T29 item29;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+                if constexpr ( i == 24 )
+                        return s.item24;
+                if constexpr ( i == 25 )
+                        return s.item25;
+                if constexpr ( i == 26 )
+                        return s.item26;
+                if constexpr ( i == 27 )
+                        return s.item27;
+                if constexpr ( i == 28 )
+                        return s.item28;
+                if constexpr ( i == 29 )
+                        return s.item29;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23,
+    typename T24,
+    typename T25,
+    typename T26,
+    typename T27,
+    typename T28,
+    typename T29,
+    typename T30 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23,
+    T24,
+    T25,
+    T26,
+    T27,
+    T28,
+    T29,
+    T30 > >
+{
+        static constexpr index_type size = 31;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
+
+        T0  item0;
+        T1  item1;
+        T2  item2;
+        T3  item3;
+        T4  item4;
+        T5  item5;
+        T6  item6;
+        T7  item7;
+        T8  item8;
+        T9  item9;
+        T10 item10;
+        T11 item11;
+        T12 item12;
+        T13 item13;
+        T14 item14;
+        T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+        T24 item24;
+        T25 item25;
+        T26 item26;
+        T27 item27;
+        T28 item28;
+        T29 item29;
+        T30 item30;
+
+
+        template < index_type i >
+        constexpr static auto& get( auto& s )
+        {
+                if constexpr ( i == 0 )
+                        return s.item0;
+                if constexpr ( i == 1 )
+                        return s.item1;
+                if constexpr ( i == 2 )
+                        return s.item2;
+                if constexpr ( i == 3 )
+                        return s.item3;
+                if constexpr ( i == 4 )
+                        return s.item4;
+                if constexpr ( i == 5 )
+                        return s.item5;
+                if constexpr ( i == 6 )
+                        return s.item6;
+                if constexpr ( i == 7 )
+                        return s.item7;
+                if constexpr ( i == 8 )
+                        return s.item8;
+                if constexpr ( i == 9 )
+                        return s.item9;
+                if constexpr ( i == 10 )
+                        return s.item10;
+                if constexpr ( i == 11 )
+                        return s.item11;
+                if constexpr ( i == 12 )
+                        return s.item12;
+                if constexpr ( i == 13 )
+                        return s.item13;
+                if constexpr ( i == 14 )
+                        return s.item14;
+                if constexpr ( i == 15 )
+                        return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+                if constexpr ( i == 24 )
+                        return s.item24;
+                if constexpr ( i == 25 )
+                        return s.item25;
+                if constexpr ( i == 26 )
+                        return s.item26;
+                if constexpr ( i == 27 )
+                        return s.item27;
+                if constexpr ( i == 28 )
+                        return s.item28;
+                if constexpr ( i == 29 )
+                        return s.item29;
+                if constexpr ( i == 30 )
+                        return s.item30;
+        }
+};
+
+
+template <
+    typename T0,
+    typename T1,
+    typename T2,
+    typename T3,
+    typename T4,
+    typename T5,
+    typename T6,
+    typename T7,
+    typename T8,
+    typename T9,
+    typename T10,
+    typename T11,
+    typename T12,
+    typename T13,
+    typename T14,
+    typename T15,
+    typename T16,
+    typename T17,
+    typename T18,
+    typename T19,
+    typename T20,
+    typename T21,
+    typename T22,
+    typename T23,
+    typename T24,
+    typename T25,
+    typename T26,
+    typename T27,
+    typename T28,
+    typename T29,
+    typename T30,
+    typename T31 >
+union _val_union< typelist<
+    T0,
+    T1,
+    T2,
+    T3,
+    T4,
+    T5,
+    T6,
+    T7,
+    T8,
+    T9,
+    T10,
+    T11,
+    T12,
+    T13,
+    T14,
+    T15,
+    T16,
+    T17,
+    T18,
+    T19,
+    T20,
+    T21,
+    T22,
+    T23,
+    T24,
+    T25,
+    T26,
+    T27,
+    T28,
+    T29,
+    T30,
+    T31 > >
+{
+        static constexpr index_type size = 32;
+
+        constexpr _val_union() noexcept
+          : null_item()
+        {
+        }
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {
+        }
+
+        _val_union_null null_item;
 
         T0  item0;
         T1  item1;
@@ -914,6 +3383,22 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T1
         T13 item13;
         T14 item14;
         T15 item15;
+        T16 item16;
+        T17 item17;
+        T18 item18;
+        T19 item19;
+        T20 item20;
+        T21 item21;
+        T22 item22;
+        T23 item23;
+        T24 item24;
+        T25 item25;
+        T26 item26;
+        T27 item27;
+        T28 item28;
+        T29 item29;
+        T30 item30;
+        T31 item31;
 
 
         template < index_type i >
@@ -951,6 +3436,38 @@ union _val_union< typelist< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T1
                         return s.item14;
                 if constexpr ( i == 15 )
                         return s.item15;
+                if constexpr ( i == 16 )
+                        return s.item16;
+                if constexpr ( i == 17 )
+                        return s.item17;
+                if constexpr ( i == 18 )
+                        return s.item18;
+                if constexpr ( i == 19 )
+                        return s.item19;
+                if constexpr ( i == 20 )
+                        return s.item20;
+                if constexpr ( i == 21 )
+                        return s.item21;
+                if constexpr ( i == 22 )
+                        return s.item22;
+                if constexpr ( i == 23 )
+                        return s.item23;
+                if constexpr ( i == 24 )
+                        return s.item24;
+                if constexpr ( i == 25 )
+                        return s.item25;
+                if constexpr ( i == 26 )
+                        return s.item26;
+                if constexpr ( i == 27 )
+                        return s.item27;
+                if constexpr ( i == 28 )
+                        return s.item28;
+                if constexpr ( i == 29 )
+                        return s.item29;
+                if constexpr ( i == 30 )
+                        return s.item30;
+                if constexpr ( i == 31 )
+                        return s.item31;
         }
 };
 
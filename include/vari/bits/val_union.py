@@ -1,55 +1,77 @@
 
-import sys
+import argparse
+
+parser = argparse.ArgumentParser(description="Generates flat _val_union specializations")
+parser.add_argument("file", help="header to regenerate in place")
+parser.add_argument(
+    "--limit", type=int, default=32,
+    help="largest number of types with a flat union, has to match _val_union_flat_limit")
+args = parser.parse_args()
+
+COLUMN_LIMIT = 100
+
+
+def wrap_list(prefix, items, suffix, indent="    "):
+    line = f"{prefix} {', '.join(items)} {suffix}"
+    if len(line) <= COLUMN_LIMIT:
+        return line + "\n"
+    body = ",\n".join(indent + i for i in items)
+    return f"{prefix}\n{body} {suffix}\n"
 
-file = sys.argv[1]
 
 def gen_union(fd, n):
+    tmpl_params = [f"typename T{i}" for i in range(n)]
+    tmpl_args = [f"T{i}" for i in range(n)]
+    width = max(len(a) for a in tmpl_args)
+    items = "".join(f"        {f'T{i}'.ljust(width)} item{i};\n" for i in range(n))
+    conditions = "".join(
+        f"                if constexpr ( i == {i} )\n                        return s.item{i};\n"
+        for i in range(n))
 
-    tmpl_params = []
-    tmpl_args = []
-    items = ""
-    conditions = ""
-    for i in range(n):
-        tmpl_params.append(f"typename T{i}")
-        tmpl_args.append(f"T{i}")
-        items += f"T{i} item{i};\n"
-        conditions += f"if constexpr ( i == {i} )\n return s.item{i};\n"
-
-    fd.write(f"""
-
-template <{",".join(tmpl_params)}>
-union _val_union< typelist< {",".join(tmpl_args)} > >
-{{
+    fd.write("\n\n")
+    fd.write(wrap_list("template <", tmpl_params, ">"))
+    fd.write(wrap_list("union _val_union< typelist<", tmpl_args, "> >"))
+    fd.write(f"""{{
         static constexpr index_type size = {n};
 
-        _val_union() noexcept {{}}
-        ~_val_union() noexcept {{}}
+        constexpr _val_union() noexcept
+          : null_item()
+        {{
+        }}
+        constexpr ~_val_union()
+                requires( _val_union_trivially_destructible< _val_union > )
+        = default;
+        constexpr ~_val_union() noexcept
+        {{
+        }}
+
+        _val_union_null null_item;
 
-        {items}
+{items}
 
         template < index_type i >
         constexpr static auto& get( auto& s )
         {{
-                {conditions}
-        }}
+{conditions}        }}
 }};
+""")
 
-    """)
 
-with open(file,"r") as fd:
+with open(args.file, "r") as fd:
     lines = list(fd.readlines())
 
 
 copy_text = True
 
-with open(file, "w") as fd:
+with open(args.file, "w") as fd:
     for line in lines:
         if copy_text:
             fd.write(line)
             if line.startswith("// VARI VAL UNION GEN START"):
                 copy_text = False
-                for i in range(1,17):
+                for i in range(1, args.limit + 1):
                     gen_union(fd, i)
+                fd.write("\n")
         else:
             if line.startswith("// VARI VAL UNION GEN END"):
                 fd.write(line)
@@ -0,0 +1,88 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace vari
+{
+
+/// Customization point declaring that two objects of type `T` are equal if and only if their object
+/// representations are equal, and that the object representation has no padding. Enabled by
+/// default for scalar types with unique object representations - integers, enums and pointers.
+/// Specialize it as `std::true_type` for aggregates with defaulted `operator==` and
+/// `std::has_unique_object_representations_v` holding.
+///
+/// Value variadics (`vval`, `vopt`) compare and hash such types with `memcmp` and a hash of their
+/// `sizeof( T )` bytes. Ordering always uses `operator<=>`, the order of bytes differs from the
+/// order of values.
+template < typename T >
+struct is_bytewise_comparable
+  : std::bool_constant< std::is_scalar_v< T > && std::has_unique_object_representations_v< T > >
+{
+};
+
+template < typename T >
+static constexpr bool is_bytewise_comparable_v = is_bytewise_comparable< T >::value;
+
+template < typename TL >
+static constexpr bool _all_bytewise_comparable_v = false;
+
+template < typename... Ts >
+static constexpr bool _all_bytewise_comparable_v< typelist< Ts... > > =
+    ( is_bytewise_comparable_v< std::remove_const_t< Ts > > && ... && true );
+
+/// Types that value variadics are able to hash.
+template < typename T >
+concept _item_hashable = _std_hashable< T > || is_bytewise_comparable_v< T >;
+
+template < typename TL >
+struct _item_sizes;
+
+template < typename... Ts >
+struct _item_sizes< typelist< Ts... > >
+{
+        // Trailing zero keeps the array non-empty for empty typelist
+        static constexpr std::size_t value[] = { sizeof( Ts )..., 0 };
+};
+
+inline std::size_t _hash_bytes( void const* p, std::size_t n ) noexcept
+{
+        return std::hash< std::string_view >{}(
+            std::string_view{ static_cast< char const* >( p ), n } );
+}
+
+inline bool _equal_bytes( void const* lh, void const* rh, std::size_t n ) noexcept
+{
+        return std::memcmp( lh, rh, n ) == 0;
+}
+
+}  // namespace vari
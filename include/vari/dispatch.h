@@ -30,15 +30,20 @@ namespace vari
 // Given `i` calls `Cnv` callable with `i` as _template argument_ and passes the result into best
 // match of callable out of `fn` set.
 //
-// `i` has to fit in range 0..N-1, any other value is undefined behavior.
-template < std::size_t N, typename Cnv, typename... Fn >
+// `i` has to fit in range 0..N-1, any other value is undefined behavior. `S` selects how is `i`
+// mapped to the template argument, see `dispatch_strategy`.
+template <
+    std::size_t       N,
+    dispatch_strategy S = default_dispatch_strategy,
+    typename Cnv,
+    typename... Fn >
 constexpr decltype( auto ) dispatch( index_type i, Cnv&& cnv, Fn&&... fn )
 {
         using types = factory_result_types_t< N, Cnv >;
 
         typename _check_unique_invocability< types >::template with_pure_value< Fn... > _{};
 
-        return _dispatch_index< 0, N >( i, [&]< index_type j >() -> decltype( auto ) {
+        return _dispatch_index< 0, N, S >( i, [&]< index_type j >() -> decltype( auto ) {
                 auto&& item = cnv.template operator()< j >();
 
                 return _dispatch_fun( (decltype( item )&&) item, (Fn&&) fn... );
@@ -45,4 +45,10 @@ class _vval;
 template < typename... Ts >
 class _vopt;
 
+template < typename T >
+struct _visit_operand;
+
+template < typename... Ts >
+class _vptr_array;
+
 }  // namespace vari
@@ -0,0 +1,250 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/index_simd.h"
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+#include "vari/concept.h"
+#include "vari/visit.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+
+namespace vari
+{
+
+/// Narrowest type able to hold index of any of the types in `TL` and the null value, which is
+/// stored as the maximum of the type. Index arrays of this type are what the kernels below work
+/// with best, but any unsigned type up to `index_type` works.
+template < typename TL >
+using index_storage_t = _index_storage_t< TL::size >;
+
+template < typename E, typename TL, typename UL >
+struct _index_subset;
+
+template < typename E, typename TL, typename... Us >
+struct _index_subset< E, TL, typelist< Us... > >
+{
+        static_assert(
+            ( vconvertible_type< Us, TL > && ... ), "All types of the subset have to be in TL" );
+
+        static constexpr std::array< E, sizeof...( Us ) > value{
+            static_cast< E >( index_of_t_or_const_t_v< Us, TL > )... };
+};
+
+template < typename E, typename TL, typename... Us >
+static constexpr auto const& _index_subset_v =
+    _index_subset< E, TL, unique_typelist_t< flatten_t< typelist< Us... > > > >::value;
+
+template < typename E, std::size_t K, typename F >
+void _for_each_match_block_impl(
+    std::span< E const >      ixs,
+    std::array< E, K > const& set,
+    std::size_t               from,
+    F&                        f ) noexcept
+{
+        static constexpr std::size_t chunk = 16;
+
+        auto const        kernel = _match_blocks_kernel< E, K >();
+        std::size_t const full   = ixs.size() / _match_block;
+        std::uint64_t     masks[chunk];
+        for ( std::size_t b = from; b < full; ) {
+                std::size_t const n = std::min( chunk, full - b );
+                kernel( ixs.data() + b * _match_block, n, set, masks );
+                for ( std::size_t i = 0; i < n; i++ )
+                        if ( f( ( b + i ) * _match_block, masks[i] ) )
+                                return;
+                b += n;
+        }
+        std::size_t const first = full * _match_block;
+        if ( first < ixs.size() && from <= full )
+                f( first, _match_partial( ixs.data() + first, ixs.size() - first, set ) );
+}
+
+// Calls `f( first, mask )` for each block of 64 elements of `ixs` starting at block `from`, with
+// `mask` marking the elements equal to any of `set`. Stops early if `f` returns true.
+template < typename E, std::size_t K, typename F >
+void _for_each_match_block(
+    std::span< E const >      ixs,
+    std::array< E, K > const& set,
+    std::size_t               from,
+    F&&                       f ) noexcept
+{
+        if constexpr ( K == 0 ) {
+                // Empty set matches nothing, the kernels require at least one index
+                for ( std::size_t b = from; b * _match_block < ixs.size(); b++ )
+                        if ( f( b * _match_block, std::uint64_t{ 0 } ) )
+                                return;
+        } else {
+                _for_each_match_block_impl( ixs, set, from, f );
+        }
+}
+
+template < typename E, std::size_t K >
+constexpr bool _matches_any( E x, std::array< E, K > const& set ) noexcept
+{
+        bool res = false;
+        for ( E const s : set )
+                res |= x == s;
+        return res;
+}
+
+/// Sets bit `i % 64` of `words[i / 64]` if `ixs[i]` is index of any of the types `Us...` in `TL`,
+/// and clears it otherwise. `words` has to have at least `( ixs.size() + 63 ) / 64` items.
+template < typename TL, typename... Us, typename E >
+void match_mask( std::span< E const > ixs, std::span< std::uint64_t > words ) noexcept
+{
+        _for_each_match_block(
+            ixs, _index_subset_v< E, TL, Us... >, 0, [&]( std::size_t first, std::uint64_t m ) {
+                    words[first / _match_block] = m;
+                    return false;
+            } );
+}
+
+/// Number of items of `ixs` that are index of any of the types `Us...` in `TL`.
+template < typename TL, typename... Us, typename E >
+std::size_t match_count( std::span< E const > ixs ) noexcept
+{
+        auto const& set = _index_subset_v< E, TL, Us... >;
+        std::size_t res = 0;
+        if constexpr ( !VARI_SIMD_X86 ) {
+                for ( E const x : ixs )
+                        res += _matches_any( x, set );
+        } else {
+                _for_each_match_block( ixs, set, 0, [&]( std::size_t, std::uint64_t m ) {
+                        res += static_cast< std::size_t >( std::popcount( m ) );
+                        return false;
+                } );
+        }
+        return res;
+}
+
+/// Writes positions of the items of `ixs` that are index of any of the types `Us...` in `TL` into
+/// `out`, in increasing order.
+template < typename TL, typename... Us, typename E, typename OutIt >
+OutIt match_positions( std::span< E const > ixs, OutIt out )
+{
+        auto const& set = _index_subset_v< E, TL, Us... >;
+        if constexpr ( !VARI_SIMD_X86 ) {
+                for ( std::size_t i = 0; i < ixs.size(); i++ )
+                        if ( _matches_any( ixs[i], set ) )
+                                *out++ = i;
+        } else {
+                _for_each_match_block( ixs, set, 0, [&]( std::size_t first, std::uint64_t m ) {
+                        for ( ; m != 0; m &= m - 1 )
+                                *out++ =
+                                    first + static_cast< std::size_t >( std::countr_zero( m ) );
+                        return false;
+                } );
+        }
+        return out;
+}
+
+/// Position of the first item of `ixs` from `from` that is index of any of the types `Us...` in
+/// `TL`, or `ixs.size()` if there is none.
+template < typename TL, typename... Us, typename E >
+std::size_t match_find_first( std::span< E const > ixs, std::size_t from = 0 ) noexcept
+{
+        auto const& set = _index_subset_v< E, TL, Us... >;
+        std::size_t res = ixs.size();
+        if ( from >= ixs.size() )
+                return res;
+        if constexpr ( !VARI_SIMD_X86 ) {
+                for ( std::size_t i = from; i < ixs.size(); i++ )
+                        if ( _matches_any( ixs[i], set ) )
+                                return i;
+        } else {
+                _for_each_match_block(
+                    ixs,
+                    set,
+                    from / _match_block,
+                    [&]( std::size_t first, std::uint64_t m ) {
+                            if ( first < from )
+                                    m &= ~std::uint64_t{ 0 } << ( from - first );
+                            if ( m == 0 )
+                                    return false;
+                            res = first + static_cast< std::size_t >( std::countr_zero( m ) );
+                            return true;
+                    } );
+        }
+        return res;
+}
+
+/// Number of items of `ixs` equal to each index of `TL`, the last item counts the rest, which are
+/// the nulls.
+template < typename TL, typename E >
+std::array< std::size_t, TL::size + 1 > index_histogram( std::span< E const > ixs ) noexcept
+{
+        std::array< std::size_t, TL::size + 1 > res{};
+        if constexpr ( VARI_SIMD_X86 && TL::size <= 8 ) {
+                // One vectorized counting pass per type is cheaper than scalar histogram for few
+                // types.
+                std::size_t sum = 0;
+                for ( std::size_t j = 0; j < TL::size; j++ ) {
+                        std::array< E, 1 > const set{ static_cast< E >( j ) };
+                        _for_each_match_block(
+                            ixs, set, 0, [&]( std::size_t, std::uint64_t m ) {
+                                    res[j] += static_cast< std::size_t >( std::popcount( m ) );
+                                    return false;
+                            } );
+                        sum += res[j];
+                }
+                res[TL::size] = ixs.size() - sum;
+        } else {
+                // Four partial histograms break the dependency between consecutive increments.
+                std::array< std::array< std::size_t, TL::size + 1 >, 4 > part{};
+                std::size_t                                              i = 0;
+                for ( ; i + 4 <= ixs.size(); i += 4 )
+                        for ( std::size_t k = 0; k < 4; k++ )
+                                part[k][std::min< std::size_t >( ixs[i + k], TL::size )] += 1;
+                for ( ; i < ixs.size(); i++ )
+                        part[0][std::min< std::size_t >( ixs[i], TL::size )] += 1;
+                for ( std::size_t j = 0; j <= TL::size; j++ )
+                        res[j] = part[0][j] + part[1][j] + part[2][j] + part[3][j];
+        }
+        return res;
+}
+
+/// Writes indexes of the elements of `r` into `out`, narrowed to `index_storage_t` of their types
+/// with null as its maximum. This adapts ranges of any variadics visitable by the free `visit` to
+/// the kernels above.
+template < std::ranges::input_range R, typename OutIt >
+        requires( _multi_visitable< std::ranges::range_reference_t< R > > )
+OutIt extract_indexes( R&& r, OutIt out )
+{
+        using V = std::remove_cvref_t< std::ranges::range_reference_t< R > >;
+        using E = index_storage_t< typename V::types >;
+        using O = _visit_operand< V >;
+        for ( auto&& e : r )
+                *out++ = static_cast< E >( O::core( e ).get_index() );
+        return out;
+}
+
+}  // namespace vari
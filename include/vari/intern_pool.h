@@ -0,0 +1,173 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+#include "vari/bits/val_core.h"
+#include "vari/forward.h"
+#include "vari/vref.h"
+#include "vari/vval.h"
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <unordered_set>
+
+namespace vari
+{
+
+/// Deduplicated storage of values of types `Ts...`. Each distinct value is stored once and
+/// `intern` returns a handle to it, so handles to equal values point to the same object and compare
+/// equal as pointers. Values are never modified nor moved, handles stay valid until `clear` or the
+/// destruction of the pool.
+///
+/// Values are hashed with the `std::hash` of `vval`, which mixes the hash of the item with its
+/// index. Lookup of a single item does not construct a `vval` unless the value is missing.
+template < typename... Ts >
+class _intern_pool
+{
+        static_assert( ( ( !std::is_const_v< Ts > && !std::is_reference_v< Ts > ) && ... ) );
+        static_assert( ( _item_hashable< Ts > && ... ) );
+
+        using core_type = _val_core< typelist< Ts... > >;
+
+public:
+        using types      = typelist< Ts... >;
+        using value_type = _vval< Ts... >;
+        using reference  = _vref< Ts const... >;
+
+        /// Returns handle to the stored value equal to `v`, `v` is stored first if there is none.
+        template < typename U >
+                requires( vconvertible_type< std::remove_cvref_t< U >, types > )
+        reference intern( U&& v )
+        {
+                auto it = _set.find( v );
+                if ( it == _set.end() )
+                        it = _set.emplace( (U&&) v ).first;
+                return *it;
+        }
+
+        /// Returns handle to the stored value equal to value of `v`, which is stored first if there
+        /// is none.
+        template < typename... Us >
+                requires( vconvertible_to< typelist< Us... >, types > )
+        reference intern( _vval< Us... > const& v )
+        {
+                return v.visit( [&]( auto const& item ) {
+                        return intern( item );
+                } );
+        }
+
+        /// True if value equal to `v` is stored.
+        template < typename U >
+                requires( vconvertible_type< U, types > )
+        [[nodiscard]] bool contains( U const& v ) const
+        {
+                return _set.find( v ) != _set.end();
+        }
+
+        /// Number of distinct values stored.
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+                return _set.size();
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+                return _set.empty();
+        }
+
+        /// Prepares storage for `n` distinct values.
+        void reserve( std::size_t n )
+        {
+                _set.reserve( n );
+        }
+
+        /// Removes all values, invalidates all handles.
+        void clear() noexcept
+        {
+                _set.clear();
+        }
+
+private:
+        // Both functors accept a stored value or any single item, which makes the lookup
+        // heterogeneous.
+        struct hasher
+        {
+                using is_transparent = void;
+
+                std::size_t operator()( value_type const& v ) const
+                {
+                        return std::hash< value_type >{}( v );
+                }
+
+                template < typename U >
+                        requires( vconvertible_type< U, types > )
+                std::size_t operator()( U const& v ) const
+                {
+                        return core_type::hash_item( index_of_t_or_const_t_v< U, types >, v );
+                }
+        };
+
+        struct equal
+        {
+                using is_transparent = void;
+
+                bool operator()( value_type const& lh, value_type const& rh ) const
+                {
+                        return lh == rh;
+                }
+
+                template < typename U >
+                        requires( vconvertible_type< U, types > )
+                bool operator()( U const& lh, value_type const& rh ) const
+                {
+                        return ( *this )( rh, lh );
+                }
+
+                template < typename U >
+                        requires( vconvertible_type< U, types > )
+                bool operator()( value_type const& lh, U const& rh ) const
+                {
+                        if ( lh.index() != index_of_t_or_const_t_v< U, types > )
+                                return false;
+                        return lh.visit( [&]< typename T >( T const& item ) {
+                                if constexpr ( std::same_as< T, U > )
+                                        return item == rh;
+                                else
+                                        return false;
+                        } );
+                }
+        };
+
+        std::unordered_set< value_type, hasher, equal > _set;
+};
+
+/// Deduplicated storage of values of types `Ts...`, see `_intern_pool`. Types are flattened and
+/// deduplicated the same way as for other variadics.
+template < typename... Ts >
+using intern_pool = _define_variadic< _intern_pool, typelist< Ts... > >;
+
+}  // namespace vari
@@ -0,0 +1,130 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace vari
+{
+
+/// Customization point declaring object representations that `T` never holds, called niches.
+/// Value variadics (`vval`, `vopt`) use them to encode the null state and the index inside the
+/// storage of `T` instead of using a separate tag.
+///
+/// Specialization has to provide:
+///  - `static constexpr std::size_t count` - number of niches available,
+///  - `static void store( void* p, std::size_t k )` - writes niche `k` into storage at `p`,
+///  - `static std::size_t load( void const* p )` - returns `k` if storage at `p` holds niche `k`, or
+///    `count` if it holds a valid `T`.
+///
+/// Constructors of `T` used with the variadic should not throw, as the storage would be left
+/// with whatever representation the constructor wrote.
+///
+/// Niches are inspected through the object representation, so variadics using them are not usable
+/// in constant expressions.
+template < typename T >
+struct niche_traits
+{
+        static constexpr std::size_t count = 0;
+};
+
+/// Implementation of `niche_traits` for trivially copyable `T` whose object representation never
+/// matches any of the values `V, Vs...`. The values have to be of type with same size as `T`.
+template < typename T, auto V, decltype( V )... Vs >
+struct niche_values
+{
+        using value_type = decltype( V );
+
+        static_assert( std::is_trivially_copyable_v< T > );
+        static_assert( sizeof( value_type ) == sizeof( T ) );
+
+        static constexpr std::size_t count = 1 + sizeof...( Vs );
+
+        static constexpr std::array< value_type, count > values = { V, Vs... };
+
+        static void store( void* p, std::size_t k ) noexcept
+        {
+                std::memcpy( p, &values[k], sizeof( T ) );
+        }
+
+        static std::size_t load( void const* p ) noexcept
+        {
+                value_type v;
+                std::memcpy( &v, p, sizeof( T ) );
+                return static_cast< std::size_t >( std::ranges::find( values, v ) - values.begin() );
+        }
+};
+
+// Niche layout of value variadic over `TL`: applies if exactly one type of `TL` is non-empty and
+// it has enough niches to encode null state and index of each other type. Niche `0` represents
+// null, niche `k` represents the `k-1`-th type out of `TL` after skipping the non-empty type.
+template < typename TL >
+struct _val_niche
+{
+        static constexpr bool enabled = false;
+};
+
+template < typename... Ts >
+        requires( sizeof...( Ts ) > 0 )
+struct _val_niche< typelist< Ts... > >
+{
+        static constexpr std::array< bool, sizeof...( Ts ) > empties = { std::is_empty_v< Ts >... };
+
+        static constexpr index_type j = static_cast< index_type >(
+            std::ranges::find( empties, false ) - empties.begin() );
+
+        using traits = niche_traits< std::remove_cv_t<
+            type_at_t< std::min< std::size_t >( j, sizeof...( Ts ) - 1 ), typelist< Ts... > > > >;
+
+        static constexpr bool enabled = std::ranges::count( empties, false ) == 1 &&
+                                        traits::count >= sizeof...( Ts );
+
+        static index_type get( void const* p ) noexcept
+        {
+                std::size_t const k = traits::load( p );
+                if ( k == traits::count )
+                        return j;
+                if ( k == 0 )
+                        return null_index;
+                return static_cast< index_type >( k - 1 < j ? k - 1 : k );
+        }
+
+        static void set( void* p, index_type i ) noexcept
+        {
+                if ( i == j )
+                        return;
+                if ( i == null_index )
+                        return traits::store( p, 0 );
+                traits::store( p, i < j ? i + 1 : i );
+        }
+};
+
+}  // namespace vari
@@ -0,0 +1,138 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+#include "vari/visit.h"
+
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace vari
+{
+
+/// Span of variadics `V` ordered by their index, as produced by `partition_by_index`. Bucket `j`
+/// holds all the elements with index `j`, nullable variadics have the null elements in the last
+/// bucket. Buckets can also be accessed by type.
+template < typename V >
+struct index_buckets
+{
+        using operand = _visit_operand< std::remove_cv_t< V > >;
+        using types   = typename std::remove_cv_t< V >::types;
+
+        static constexpr index_type count = operand::size;
+
+        std::span< V > items;
+
+        // Bucket `j` is `[bounds[j], bounds[j + 1])` of the `items`.
+        std::array< std::size_t, count + 1 > bounds = {};
+
+        [[nodiscard]] constexpr std::span< V > operator[]( index_type j ) const noexcept
+        {
+                return items.subspan( bounds[j], bounds[j + 1] - bounds[j] );
+        }
+
+        template < typename T >
+                requires( contains_type_v< T, types > )
+        [[nodiscard]] constexpr std::span< V > get() const noexcept
+        {
+                return ( *this )[index_of_t_or_const_t_v< T, types >];
+        }
+
+        [[nodiscard]] constexpr std::span< V > null_bucket() const noexcept
+                requires( operand::nullable )
+        {
+                return ( *this )[count - 1];
+        }
+};
+
+/// Stably reorders the elements of `r` so that the elements with equal index are next to each
+/// other, in order of the indexes, and returns the boundaries of the groups. This is a counting
+/// sort: one pass counts the indexes, the elements are then permuted in place by swaps, with one
+/// temporary destination offset per element.
+template < std::ranges::contiguous_range R >
+        requires(
+            std::ranges::borrowed_range< R > &&
+            _multi_visitable< std::ranges::range_value_t< R > > )
+constexpr auto partition_by_index( R&& r )
+{
+        using V = std::remove_reference_t< std::ranges::range_reference_t< R > >;
+        using O = _visit_operand< std::remove_cv_t< V > >;
+
+        index_buckets< V > res{ .items = std::span< V >( r ) };
+        std::span< V >     s = res.items;
+
+        std::vector< index_type > ixs( s.size() );
+        for ( std::size_t i = 0; i < s.size(); i++ ) {
+                ixs[i] = O::index( O::core( s[i] ) );
+                res.bounds[ixs[i] + 1] += 1;
+        }
+        for ( index_type j = 0; j < O::size; j++ )
+                res.bounds[j + 1] += res.bounds[j];
+
+        std::array< std::size_t, O::size > next;
+        for ( index_type j = 0; j < O::size; j++ )
+                next[j] = res.bounds[j];
+        std::vector< std::size_t > dst( s.size() );
+        for ( std::size_t i = 0; i < s.size(); i++ )
+                dst[i] = next[ixs[i]]++;
+
+        using std::swap;
+        for ( std::size_t i = 0; i < s.size(); i++ ) {
+                while ( dst[i] != i ) {
+                        std::size_t const d = dst[i];
+                        swap( s[i], s[d] );
+                        std::swap( dst[i], dst[d] );
+                }
+        }
+        return res;
+}
+
+/// Runs the one callable out of `fs...` invocable with items of bucket `j` over all the elements
+/// of the bucket, for each bucket in order. Nulls are passed as `empty_t`. Types of the buckets are
+/// known at compile time, so this does no dispatch at all.
+template < typename V, typename... Fs >
+constexpr void visit_buckets( index_buckets< V > const& b, Fs&&... fs )
+{
+        using O  = typename index_buckets< V >::operand;
+        using XL = typename O::template arg_types< std::is_const_v< V > >;
+        typename _check_unique_invocability< XL >::template with_pure_value< Fs&... > _{};
+
+        [&]< index_type... js >( std::integer_sequence< index_type, js... > ) {
+                (
+                    [&] {
+                            auto& f = _function_picker< type_at_t< js, XL > >::pick( fs... );
+                            for ( V& e : b[js] )
+                                    f( O::template get< js >( O::core( e ) ) );
+                    }(),
+                    ... );
+        }( std::make_integer_sequence< index_type, O::size >{} );
+}
+
+}  // namespace vari
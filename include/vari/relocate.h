@@ -0,0 +1,110 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/typelist.h"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace vari
+{
+
+/// Customization point declaring that object of type `T` can be relocated - moved into new storage
+/// with the original destroyed - by copying its object representation. Enabled by default for
+/// trivially copyable types. Specialize it as `std::true_type` for types whose value does not
+/// depend on their own address, such as `std::unique_ptr` or most handle types.
+///
+/// Value variadics (`vval`, `vopt`) are trivially relocatable if all their types are, and use it
+/// to swap and move values between storages bytewise.
+template < typename T >
+struct is_trivially_relocatable : std::bool_constant< std::is_trivially_copyable_v< T > >
+{
+};
+
+template < typename T >
+static constexpr bool is_trivially_relocatable_v = is_trivially_relocatable< T >::value;
+
+template < typename TL >
+static constexpr bool _all_trivially_relocatable_v = false;
+
+template < typename... Ts >
+static constexpr bool _all_trivially_relocatable_v< typelist< Ts... > > =
+    ( is_trivially_relocatable_v< Ts > && ... && true );
+
+template < typename TL >
+static constexpr bool _all_trivially_copyable_v = false;
+
+template < typename... Ts >
+static constexpr bool _all_trivially_copyable_v< typelist< Ts... > > =
+    ( std::is_trivially_copyable_v< Ts > && ... && true );
+
+template < typename T >
+static constexpr bool _nothrow_relocatable_v =
+    is_trivially_relocatable_v< T > ||
+    ( std::is_nothrow_move_constructible_v< T > && std::is_nothrow_destructible_v< T > );
+
+/// Relocates object at `src` into uninitialized storage at `dst` and returns pointer to the new
+/// object. After the call, `src` is uninitialized storage that shall not be destroyed.
+template < typename T >
+T* relocate_at( T* src, T* dst ) noexcept( _nothrow_relocatable_v< T > )
+{
+        if constexpr ( is_trivially_relocatable_v< T > ) {
+                std::memcpy(
+                    static_cast< void* >( dst ), static_cast< void const* >( src ), sizeof( T ) );
+                return std::launder( dst );
+        } else {
+                T* res = std::construct_at( dst, std::move( *src ) );
+                std::destroy_at( src );
+                return res;
+        }
+}
+
+/// Relocates `n` objects starting at `src` into uninitialized storage starting at `dst`, the ranges
+/// shall not overlap. Intended for containers growing their buffer. Returns pointer past the last
+/// relocated object.
+///
+/// If `T` is not trivially relocatable and its move constructor throws, objects relocated so far
+/// stay in `dst` and the rest stays in `src`.
+template < typename T >
+T* relocate_n( T* src, std::size_t n, T* dst ) noexcept( _nothrow_relocatable_v< T > )
+{
+        if constexpr ( is_trivially_relocatable_v< T > ) {
+                if ( n != 0 )
+                        std::memcpy(
+                            static_cast< void* >( dst ),
+                            static_cast< void const* >( src ),
+                            n * sizeof( T ) );
+                return dst + n;
+        } else {
+                for ( std::size_t i = 0; i < n; i++ )
+                        relocate_at( src + i, dst + i );
+                return dst + n;
+        }
+}
+
+}  // namespace vari
@@ -153,14 +153,14 @@ public:
         /// or `void&` otherwise. Undefined behavior on null pointer.
         constexpr auto& operator*() const noexcept
         {
-                return *_core.ptr;
+                return *_core.get_ptr();
         }
 
         /// Provides member access to the pointed-to type. It is `T*` if there is only one type in
         /// `Ts...`, or `void*` otherwise. Undefined behavior on null pointer.
         constexpr auto* operator->() const noexcept
         {
-                return _core.ptr;
+                return _core.get_ptr();
         }
 
         /// Returns a `pointer` to the pointed-to type.
@@ -250,16 +250,17 @@ public:
 
         /// Calls the appropriate function from the list `fs...`, based on the type of the current
         /// target, or one with `empty_t` in case of null pointer.
-        template < typename... Fs >
+        /// `S` selects how is the type dispatched, see `dispatch_strategy`.
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit( Fs&&... f ) const
         {
 
                 typename _check_unique_invocability< types >::template with_nullable_pure_ref<
                     Fs... >
                     _{};
-                if ( _core.ptr == nullptr )
+                if ( _core.get_ptr() == nullptr )
                         return _dispatch_fun( empty, (Fs&&) f... );
-                return _core.visit_impl( (Fs&&) f... );
+                return _core.template visit_impl< S >( (Fs&&) f... );
         }
 
         /// Constructs an owning reference to currently pointed-to type and transfers ownership to
@@ -272,7 +273,7 @@ public:
                     Deleter >::template with_nullable_uvref< Fs... >
                      _{};
                 auto p = release();
-                if ( p._core.ptr == nullptr )
+                if ( p._core.get_ptr() == nullptr )
                         return _dispatch_fun( empty, (Fs&&) fs... );
                 return p._core.template take_impl< same_uvref >( (Fs&&) fs... );
         }
@@ -314,6 +315,8 @@ private:
 
         template < typename Deleter2, typename... Us >
         friend class _uvref;
+        template < typename T >
+        friend struct _visit_operand;
 };
 
 /// Compares the internal pointers of both pointers.
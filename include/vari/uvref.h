@@ -120,20 +120,20 @@ public:
         /// or `void&` otherwise.
         constexpr auto& operator*() const noexcept
         {
-                return *_core.ptr;
+                return *_core.get_ptr();
         }
 
         /// Provides member access to the pointed-to type. It is `T*` if there is only one type in
         /// `Ts...`, or `void*` otherwise.
         constexpr auto* operator->() const noexcept
         {
-                return _core.ptr;
+                return _core.get_ptr();
         }
 
         /// Returns a `reference` to the pointed-to type.
         constexpr reference get() const noexcept
         {
-                VARI_ASSERT( _core.ptr );
+                VARI_ASSERT( _core.get_ptr() );
                 reference res;
                 res._core = _core;
                 return res;
@@ -143,8 +143,8 @@ public:
         /// The index of the first type is 0, with subsequent types sequentially numbered.
         [[nodiscard]] constexpr index_type index() const noexcept
         {
-                VARI_ASSERT( _core.ptr );
-                return _core.index;
+                VARI_ASSERT( _core.get_ptr() );
+                return _core.get_index();
         }
 
         /// Conversion operator from lvalue reference to types-compatible `vref`
@@ -153,7 +153,7 @@ public:
                 requires( vconvertible_to< types, typelist< Us... > > )
         constexpr operator _vref< Us... >() & noexcept
         {
-                VARI_ASSERT( _core.ptr );
+                VARI_ASSERT( _core.get_ptr() );
                 return vptr().vref();
         }
         /// Conversion operator from lvalue const reference to types-compatible `vref`
@@ -162,7 +162,7 @@ public:
                 requires( vconvertible_to< types, typelist< Us... > > )
         constexpr operator _vref< Us... >() const& noexcept
         {
-                VARI_ASSERT( _core.ptr );
+                VARI_ASSERT( _core.get_ptr() );
                 return vptr().vref();
         }
 
@@ -174,7 +174,7 @@ public:
         ///
         constexpr pointer vptr() const& noexcept
         {
-                VARI_ASSERT( _core.ptr );
+                VARI_ASSERT( _core.get_ptr() );
                 pointer res;
                 res._core = _core;
                 return res;
@@ -184,7 +184,7 @@ public:
         /// pointer.
         constexpr owning_pointer vptr() && noexcept
         {
-                VARI_ASSERT( _core.ptr );
+                VARI_ASSERT( _core.get_ptr() );
                 owning_pointer res;
                 swap( res._core, _core );
                 return res;
@@ -192,12 +192,13 @@ public:
 
         /// Calls the appropriate function from the list `fs...`, based on the type of the current
         /// target.
-        template < typename... Fs >
+        /// `S` selects how is the type dispatched, see `dispatch_strategy`.
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit( Fs&&... f ) const
         {
                 typename _check_unique_invocability< types >::template with_pure_ref< Fs... > _{};
-                VARI_ASSERT( _core.ptr );
-                return _core.visit_impl( (Fs&&) f... );
+                VARI_ASSERT( _core.get_ptr() );
+                return _core.template visit_impl< S >( (Fs&&) f... );
         }
 
         /// Constructs an owning reference to currently pointed-to type and transfers ownership to
@@ -208,7 +209,7 @@ public:
                 typename _check_unique_invocability< types >::template with_deleter<
                     Deleter >::template with_uvref< Fs... >
                     _{};
-                VARI_ASSERT( _core.ptr );
+                VARI_ASSERT( _core.get_ptr() );
                 auto tmp = _core;
                 _core.reset();
                 return tmp.template take_impl< same_uvref >( (Fs&&) fs... );
@@ -257,6 +258,8 @@ private:
 
         template < typename Deleter2, typename... Us >
         friend class _uvref;
+        template < typename T >
+        friend struct _visit_operand;
 };
 
 /// Compares the internal pointers of both references.
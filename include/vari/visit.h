@@ -0,0 +1,443 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/dispatch.h"
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+#include "vari/forward.h"
+#include "vari/uvptr.h"
+#include "vari/uvref.h"
+#include "vari/vopt.h"
+#include "vari/vptr.h"
+#include "vari/vref.h"
+#include "vari/vval.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+
+#ifndef VARI_PREFETCH_DISTANCE
+#define VARI_PREFETCH_DISTANCE 8
+#endif
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define VARI_COLD [[gnu::cold, gnu::noinline]]
+#elif defined( _MSC_VER )
+#define VARI_COLD __declspec( noinline )
+#else
+#define VARI_COLD
+#endif
+
+namespace vari
+{
+
+/// Default number of elements `visit_range_prefetch` looks ahead, from `VARI_PREFETCH_DISTANCE`.
+static constexpr std::size_t default_prefetch_distance = VARI_PREFETCH_DISTANCE;
+
+/// Customization point selecting how many cache lines from the start of an object of type `T`
+/// `visit_range_prefetch` prefetches. Specialize it for types whose visit touches more than the
+/// first line, or as zero for types that are not accessed at all.
+template < typename T >
+struct prefetch_traits
+{
+        static constexpr std::size_t lines = 1;
+};
+
+static constexpr std::size_t _cache_line = 64;
+
+// Forced inline: GCC treats the builtin as side-effect free, a wrapper left out of line would be
+// deduced pure and its calls dropped.
+#if defined( __GNUC__ ) || defined( __clang__ )
+[[gnu::always_inline]]
+#endif
+inline void _prefetch( void const* p ) noexcept
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+        __builtin_prefetch( p, 0, 3 );
+#else
+        (void) p;
+#endif
+}
+
+// Describes one operand of the multi-variadic `visit`, `types` are the types of the variadic. Index
+// space of the operand has `size` entries, null state of nullable variadics is mapped to the last
+// one. `arg_types` are the types of arguments the callables are invoked with, `get< j >` provides
+// the argument for entry `j`. `item_types` and `item_ptr` give type-erased access to the current
+// item, used by `visitor`. Items of `indirect` operands are stored elsewhere, `prefetch_lines` is
+// indexed by the entry and is zero for the null entry.
+template < bool Nullable, typename... Ts >
+struct _visit_ptr_operand
+{
+        static constexpr bool       nullable = Nullable;
+        static constexpr bool       indirect = true;
+        static constexpr index_type size     = sizeof...( Ts ) + ( Nullable ? 1 : 0 );
+
+        using types = typelist< Ts... >;
+
+        static constexpr std::size_t prefetch_lines[sizeof...( Ts ) + 1] = {
+            prefetch_traits< std::remove_const_t< Ts > >::lines...,
+            0 };
+
+        template < bool Const >
+        using item_types = typelist< Ts... >;
+
+        template < bool Const >
+        using arg_types =
+            std::conditional_t< Nullable, typelist< Ts&..., empty_t >, typelist< Ts&... > >;
+
+        static constexpr void* item_ptr( auto const& core ) noexcept
+        {
+                return const_cast< void* >( static_cast< void const* >( core.get_ptr() ) );
+        }
+
+        static constexpr index_type index( auto const& core ) noexcept
+        {
+                index_type const i = core.get_index();
+                if constexpr ( Nullable )
+                        return i == null_index ? index_type{ sizeof...( Ts ) } : i;
+                else
+                        return i;
+        }
+
+        template < index_type j >
+        static constexpr decltype( auto ) get( auto const& core ) noexcept
+        {
+                if constexpr ( j == sizeof...( Ts ) )
+                        return empty_t{};
+                else
+                        return *static_cast< type_at_t< j, typelist< Ts... > >* >(
+                            core.get_ptr() );
+        }
+};
+
+template < bool Nullable, typename... Ts >
+struct _visit_val_operand
+{
+        using ST = _val_union< typelist< Ts... > >;
+
+        static constexpr bool       nullable = Nullable;
+        static constexpr bool       indirect = false;
+        static constexpr index_type size     = sizeof...( Ts ) + ( Nullable ? 1 : 0 );
+
+        using types = typelist< Ts... >;
+
+        template < bool Const >
+        using item_types =
+            std::conditional_t< Const, typelist< Ts const... >, typelist< Ts... > >;
+
+        template < bool Const >
+        using arg_types = std::conditional_t<
+            Const,
+            std::conditional_t<
+                Nullable,
+                typelist< Ts const&..., empty_t >,
+                typelist< Ts const&... > >,
+            std::conditional_t< Nullable, typelist< Ts&..., empty_t >, typelist< Ts&... > > >;
+
+        static constexpr index_type index( auto const& core ) noexcept
+        {
+                index_type const i = core.get_index();
+                if constexpr ( Nullable )
+                        return i == null_index ? index_type{ sizeof...( Ts ) } : i;
+                else
+                        return i;
+        }
+
+        template < index_type j >
+        static constexpr decltype( auto ) get( auto& core ) noexcept
+        {
+                if constexpr ( j == sizeof...( Ts ) )
+                        return empty_t{};
+                else
+                        return ST::template get< j >( core.storage );
+        }
+
+        // All members of the union share its address.
+        static constexpr void* item_ptr( auto const& core ) noexcept
+        {
+                return const_cast< void* >( static_cast< void const* >( &core.storage ) );
+        }
+};
+
+template < typename... Ts >
+struct _visit_operand< _vptr< Ts... > > : _visit_ptr_operand< true, Ts... >
+{
+        static constexpr auto const& core( _vptr< Ts... > const& p ) noexcept
+        {
+                return p._core;
+        }
+};
+
+template < typename... Ts >
+struct _visit_operand< _vref< Ts... > > : _visit_ptr_operand< false, Ts... >
+{
+        static constexpr auto const& core( _vref< Ts... > const& r ) noexcept
+        {
+                return r._core;
+        }
+};
+
+template < typename Deleter, typename... Ts >
+struct _visit_operand< _uvptr< Deleter, Ts... > > : _visit_ptr_operand< true, Ts... >
+{
+        static constexpr auto const& core( _uvptr< Deleter, Ts... > const& p ) noexcept
+        {
+                return p._core;
+        }
+};
+
+template < typename Deleter, typename... Ts >
+struct _visit_operand< _uvref< Deleter, Ts... > > : _visit_ptr_operand< false, Ts... >
+{
+        static constexpr auto const& core( _uvref< Deleter, Ts... > const& r ) noexcept
+        {
+                return r._core;
+        }
+};
+
+template < typename... Ts >
+struct _visit_operand< _vval< Ts... > > : _visit_val_operand< false, Ts... >
+{
+        template < typename V >
+        static constexpr auto& core( V& v ) noexcept
+        {
+                return v._core;
+        }
+};
+
+template < typename... Ts >
+struct _visit_operand< _vopt< Ts... > > : _visit_val_operand< true, Ts... >
+{
+        template < typename V >
+        static constexpr auto& core( V& v ) noexcept
+        {
+                return v._core;
+        }
+};
+
+template < typename T >
+concept _multi_visitable = requires { _visit_operand< std::remove_cvref_t< T > >::size; };
+
+/// Calls the one callable out of `fs...` that is invocable with the current items of both `a` and
+/// `b`. Nullable variadics pass `empty_t` if they are null. Both operands are resolved by a single
+/// dispatch over the combined index `ia * size_b + ib`, instead of nesting one visit inside
+/// another. Exactly one callable has to match each combination of the types.
+template <
+    dispatch_strategy S = default_dispatch_strategy,
+    _multi_visitable A,
+    _multi_visitable B,
+    typename... Fs >
+constexpr decltype( auto ) visit( A&& a, B&& b, Fs&&... fs )
+{
+        using OA = _visit_operand< std::remove_cvref_t< A > >;
+        using OB = _visit_operand< std::remove_cvref_t< B > >;
+        using XL =
+            typename OA::template arg_types< std::is_const_v< std::remove_reference_t< A > > >;
+        using YL =
+            typename OB::template arg_types< std::is_const_v< std::remove_reference_t< B > > >;
+        typename _check_unique_pair_invocability< XL, YL >::template with< Fs... > _{};
+
+        auto& ca = OA::core( a );
+        auto& cb = OB::core( b );
+
+        _profile_visit< typename OA::types >( OA::index( ca ) );
+        _profile_visit< typename OB::types >( OB::index( cb ) );
+        index_type const k = OA::index( ca ) * OB::size + OB::index( cb );
+        return _dispatch_index< 0, OA::size * OB::size, S >(
+            k, [&]< index_type j >() -> decltype( auto ) {
+                    decltype( auto ) x = OA::template get< j / OB::size >( ca );
+                    decltype( auto ) y = OB::template get< j % OB::size >( cb );
+                    auto&& f =
+                        _function_picker< decltype( x ), decltype( y ) >::pick( (Fs&&) fs... );
+                    return ( (decltype( f )&&) f )( (decltype( x )&&) x, (decltype( y )&&) y );
+            } );
+}
+
+// Index of `T` in the index space of operand `O`, `empty_t` maps to the null entry.
+template < typename O, typename T >
+static constexpr index_type _visit_index_of =
+    index_of_t_or_const_t_v< T, typename O::template item_types< false > >;
+
+template < typename O >
+static constexpr index_type _visit_index_of< O, empty_t > = O::size - 1;
+
+/// Calls the one callable out of `fs...` invocable with the current item of `v`, like the member
+/// `visit`. The index of `T` is compared first in a branch marked as likely, other indexes go
+/// through the dispatch selected by `S`. Meant for call sites that nearly always see the same
+/// alternative, `T` is one of the types of `v`, or `empty_t` for null of nullable variadics.
+template <
+    typename T,
+    dispatch_strategy S = default_dispatch_strategy,
+    _multi_visitable V,
+    typename... Fs >
+constexpr decltype( auto ) visit_likely( V&& v, Fs&&... fs )
+{
+        using O = _visit_operand< std::remove_cvref_t< V > >;
+        using XL =
+            typename O::template arg_types< std::is_const_v< std::remove_reference_t< V > > >;
+        typename _check_unique_invocability< XL >::template with_pure_value< Fs... > _{};
+        static_assert(
+            !std::is_same_v< T, empty_t > || O::nullable,
+            "Only nullable variadics can have null as the likely alternative" );
+
+        auto& c = O::core( v );
+        _profile_visit< typename O::types >( O::index( c ) );
+        return _dispatch_likely< _visit_index_of< O, T >, 0, O::size, S >(
+            O::index( c ), [&]< index_type j >() -> decltype( auto ) {
+                    decltype( auto ) x = O::template get< j >( c );
+                    return _dispatch_fun( (decltype( x )&&) x, (Fs&&) fs... );
+            } );
+}
+
+/// Callable created by `cold`, calls `f` from a function that is never inlined and is marked as
+/// rarely executed.
+template < typename F >
+struct cold_callable
+{
+        F f;
+
+        template < typename... Args >
+                requires( invocable< F&, Args... > )
+        VARI_COLD constexpr decltype( auto ) operator()( Args&&... args )
+        {
+                return f( (Args&&) args... );
+        }
+
+        template < typename... Args >
+                requires( invocable< F const&, Args... > )
+        VARI_COLD constexpr decltype( auto ) operator()( Args&&... args ) const
+        {
+                return f( (Args&&) args... );
+        }
+};
+
+/// Marks `f` as handler of rare alternatives, for any of the visits. Its body is kept out of the
+/// visiting function and the compiler lays out the path to it as unlikely, so the code of the hot
+/// alternatives stays compact.
+template < typename F >
+constexpr cold_callable< std::decay_t< F > > cold( F&& f )
+{
+        return { (F&&) f };
+}
+
+/// Calls the one callable out of `fs...` invocable with the current item of each element of `r`,
+/// elements are visited in order and results of the callables are discarded. Elements have to be
+/// variadics visitable by the free `visit`, null is passed as `empty_t`.
+///
+/// Consecutive elements with equal index form a run. Dispatch happens once per run, the selected
+/// callable is then called in a loop over the whole run, so the body of the loop can be inlined.
+/// Ranges clustered by type pay for one dispatch per cluster instead of one per element.
+template <
+    dispatch_strategy S = default_dispatch_strategy,
+    std::ranges::input_range R,
+    typename... Fs >
+        requires( _multi_visitable< std::ranges::range_reference_t< R > > )
+constexpr void visit_range( R&& r, Fs&&... fs )
+{
+        using E  = std::ranges::range_reference_t< R >;
+        using O  = _visit_operand< std::remove_cvref_t< E > >;
+        using XL =
+            typename O::template arg_types< std::is_const_v< std::remove_reference_t< E > > >;
+        typename _check_unique_invocability< XL >::template with_pure_value< Fs&... > _{};
+
+        auto       it  = std::ranges::begin( r );
+        auto const end = std::ranges::end( r );
+        while ( it != end ) {
+                auto&&           first = *it;
+                index_type const i     = O::index( O::core( first ) );
+                _profile_visit< typename O::types >( i );
+                _dispatch_index< 0, O::size, S >( i, [&]< index_type j >() {
+                        auto& f = _function_picker< type_at_t< j, XL > >::pick( fs... );
+                        f( O::template get< j >( O::core( first ) ) );
+                        for ( ++it; it != end; ++it ) {
+                                auto&& e = *it;
+                                auto&  c = O::core( e );
+                                if ( O::index( c ) != j )
+                                        return;
+                                _profile_visit< typename O::types >( j );
+                                f( O::template get< j >( c ) );
+                        }
+                } );
+        }
+}
+
+// Prefetches the lines of the item pointed to by `e`. Forced inline for the same reason as
+// `_prefetch`, a call of it would be dropped as well.
+template < typename O, typename E >
+#if defined( __GNUC__ ) || defined( __clang__ )
+[[gnu::always_inline]]
+#endif
+inline void _prefetch_item( E const& e ) noexcept
+{
+        auto const&       c     = O::core( e );
+        std::size_t const lines = O::prefetch_lines[O::index( c )];
+        auto const*       p     = static_cast< char const* >( O::item_ptr( c ) );
+        for ( std::size_t k = 0; k < lines; k++ )
+                _prefetch( p + k * _cache_line );
+}
+
+/// Visits each element of `r` like a per-element `visit`, for ranges of pointer variadics (`vptr`,
+/// `vref`, `uvptr`, `uvref`). Before element `i` is visited, the object pointed to by element
+/// `i + D` is prefetched, `prefetch_traits` of its type select how many cache lines. Ranges of
+/// pointers to objects scattered over the heap otherwise wait for a cache miss on each element.
+///
+/// `D` should cover the memory latency: roughly the latency divided by the time spent visiting
+/// one element. Too short a distance leaves part of the miss, too long one evicts the prefetched
+/// lines before they are used.
+template <
+    std::size_t       D = default_prefetch_distance,
+    dispatch_strategy S = default_dispatch_strategy,
+    std::ranges::random_access_range R,
+    typename... Fs >
+        requires(
+            _multi_visitable< std::ranges::range_reference_t< R > > &&
+            _visit_operand< std::remove_cvref_t< std::ranges::range_reference_t< R > > >::indirect )
+void visit_range_prefetch( R&& r, Fs&&... fs )
+{
+        using E  = std::ranges::range_reference_t< R >;
+        using O  = _visit_operand< std::remove_cvref_t< E > >;
+        using XL = typename O::template arg_types< false >;
+        typename _check_unique_invocability< XL >::template with_pure_value< Fs&... > _{};
+
+        auto const        first = std::ranges::begin( r );
+        std::size_t const n     = static_cast< std::size_t >( std::ranges::distance( r ) );
+
+        for ( std::size_t i = 0; i < std::min( D, n ); i++ )
+                _prefetch_item< O >( first[i] );
+        for ( std::size_t i = 0; i < n; i++ ) {
+                if ( i + D < n )
+                        _prefetch_item< O >( first[i + D] );
+                auto&&      e = first[i];
+                auto const& c = O::core( e );
+                _profile_visit< typename O::types >( O::index( c ) );
+                _dispatch_index< 0, O::size, S >( O::index( c ), [&]< index_type j >() {
+                        _function_picker< type_at_t< j, XL > >::pick( fs... )(
+                            O::template get< j >( c ) );
+                } );
+        }
+}
+
+}  // namespace vari
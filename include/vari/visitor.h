@@ -0,0 +1,159 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+#include "vari/concept.h"
+#include "vari/visit.h"
+
+#include <array>
+#include <tuple>
+
+namespace vari
+{
+
+template < typename TL, typename... Fs >
+class _visitor;
+
+/// Visitor over the types `Ts...` that owns the callables `Fs...`. Selection of the callable for
+/// each type and the invocability checks are done once, when the visitor type is instantiated.
+/// Visiting then converts the index of the variadic into index of `Ts...` and does one indirect
+/// call through a static table of thunks.
+///
+/// Visitor can be applied to any of `vptr`, `vref`, `uvptr`, `uvref`, `vval` and `vopt` whose
+/// types are subset of `Ts...`. Items of const `vval` and `vopt` are const, so `Ts...` have to
+/// contain the const types to visit those. Nullable variadics require a callable for `empty_t`.
+template < typename... Ts, typename... Fs >
+class _visitor< typelist< Ts... >, Fs... >
+{
+        static_assert( sizeof...( Ts ) > 0, "Visitor has to have at least one type" );
+
+public:
+        using types = typelist< Ts... >;
+
+        static constexpr bool handles_null = ( invocable< Fs const&, empty_t > || ... );
+
+        using result_type = decltype( _function_picker< type_at_t< 0, types >& >::pick(
+            std::declval< Fs const& >()... )( std::declval< type_at_t< 0, types >& >() ) );
+
+        // Excludes single argument of the visitor itself, copies have to use the copy constructor
+        template < typename... Us >
+                requires(
+                    sizeof...( Us ) == sizeof...( Fs ) &&
+                    !( sizeof...( Us ) == 1 &&
+                       ( std::same_as< std::remove_cvref_t< Us >, _visitor > && ... ) ) )
+        constexpr explicit _visitor( Us&&... fs )
+          : _fs( (Us&&) fs... )
+        {
+                using check = _check_unique_invocability< types >;
+                using with  = std::conditional_t<
+                    handles_null,
+                    typename check::template with_nullable_pure_ref< Fs const&... >,
+                    typename check::template with_pure_ref< Fs const&... > >;
+                with _{};
+        }
+
+        template < typename V >
+                requires(
+                    _multi_visitable< V > &&
+                    vconvertible_to<
+                        typename _visit_operand< std::remove_cvref_t< V > >::template item_types<
+                            std::is_const_v< std::remove_reference_t< V > > >,
+                        types > )
+        result_type operator()( V&& v ) const
+        {
+                using O  = _visit_operand< std::remove_cvref_t< V > >;
+                using UL = typename O::template item_types<
+                    std::is_const_v< std::remove_reference_t< V > > >;
+                static_assert(
+                    !O::nullable || handles_null,
+                    "Nullable variadic requires a callable for empty_t" );
+
+                auto const&      core = O::core( v );
+                index_type const i    = core.get_index();
+                index_type       k    = sizeof...( Ts );
+                if ( i != null_index ) {
+                        if constexpr ( std::same_as< UL, types > )
+                                k = i;
+                        else
+                                k = _vptr_cnv_map< types, UL >::conv( i );
+                }
+                return _thunks()[k]( *this, O::item_ptr( core ) );
+        }
+
+private:
+        using thunk_type = result_type ( * )( _visitor const&, void* );
+
+        template < index_type j >
+        static result_type _thunk( _visitor const& self, void* p )
+        {
+                return std::apply(
+                    [&]( Fs const&... fs ) -> result_type {
+                            if constexpr ( j == sizeof...( Ts ) ) {
+                                    return _function_picker< empty_t >::pick( fs... )( empty_t{} );
+                            } else {
+                                    using T = type_at_t< j, types >;
+                                    return _function_picker< T& >::pick( fs... )(
+                                        *static_cast< T* >( p ) );
+                            }
+                    },
+                    self._fs );
+        }
+
+        template < std::size_t... js >
+        static constexpr std::array< thunk_type, sizeof...( Ts ) + 1 >
+        _make_thunks( std::index_sequence< js... > )
+        {
+                if constexpr ( handles_null )
+                        return { &_thunk< js >..., &_thunk< sizeof...( Ts ) > };
+                else
+                        return { &_thunk< js >..., nullptr };
+        }
+
+        // Index `sizeof...( Ts )` is the null state.
+        static thunk_type const* _thunks() noexcept
+        {
+                static constexpr std::array< thunk_type, sizeof...( Ts ) + 1 > table =
+                    _make_thunks( std::index_sequence_for< Ts... >{} );
+                return table.data();
+        }
+
+        std::tuple< Fs... > _fs;
+};
+
+/// Visitor over types `TL` holding callables `Fs...`, see `_visitor`. `TL` is flattened the same
+/// way as types of variadics, so type-sets can be used, and ordered the same way, so the visitor
+/// over the types of a variadic visits it without conversion of the index.
+template < typename TL, typename... Fs >
+using visitor = _visitor< _ordered_typelist_t< unique_typelist_t< flatten_t< TL > > >, Fs... >;
+
+/// Constructs visitor over types `TL` that owns copies of `fs...`.
+template < typename TL, typename... Fs >
+constexpr visitor< TL, std::decay_t< Fs >... > make_visitor( Fs&&... fs )
+{
+        return visitor< TL, std::decay_t< Fs >... >{ (Fs&&) fs... };
+}
+
+}  // namespace vari
@@ -38,6 +38,12 @@
 namespace vari
 {
 
+template < typename T >
+static constexpr bool _is_vopt = false;
+
+template < typename... Ts >
+static constexpr bool _is_vopt< _vopt< Ts... > > = true;
+
 // WARNING: experimental
 // WARNING: untested
 template < typename... Ts >
@@ -69,10 +75,12 @@ public:
                 _core.template emplace< U >( (Args&&) args... );
         }
 
-        constexpr _vopt( _vopt&& p ) noexcept( std::is_nothrow_move_constructible_v< core_type > )
-          : _core( std::move( p._core ) )
-        {
-        }
+        // Defaulted, so these are trivial whenever the same member of the core is trivial.
+        constexpr _vopt( _vopt&& )                 = default;
+        constexpr _vopt( _vopt const& )            = default;
+        constexpr _vopt& operator=( _vopt&& )      = default;
+        constexpr _vopt& operator=( _vopt const& ) = default;
+        constexpr ~_vopt()                         = default;
 
         template < typename... Us >
                 requires( vconvertible_to< typelist< Us... >, types > )
@@ -90,12 +98,6 @@ public:
         {
         }
 
-        constexpr _vopt( _vopt const& p ) noexcept(
-            std::is_nothrow_copy_constructible_v< core_type > )
-          : _core( p._core )
-        {
-        }
-
         template < typename... Us >
                 requires( vconvertible_to< typelist< Us... >, types > )
         constexpr _vopt( _vopt< Us... > const& p ) noexcept(
@@ -116,19 +118,10 @@ public:
 
         template < typename U >
                 requires( vconvertible_type< std::remove_cvref_t< U >, types > )
-        constexpr _vopt& operator=( U&& v ) noexcept( _forward_nothrow_constructible< U > )
+        constexpr _vopt& operator=( U&& v ) noexcept(
+            core_type::template is_nothrow_value_assignable< std::remove_cvref_t< U >, U > )
         {
-                if ( _core.index != null_index )
-                        _core.destroy();
-                _core.template emplace< std::remove_cvref_t< U > >( (U&&) v );
-                return *this;
-        }
-
-        constexpr _vopt& operator=( _vopt&& p ) noexcept(
-            core_type::template is_nothrow_assignable< typename _vopt::core_type&& > )
-        {
-                // XXX not null friendly
-                _core.assign( std::move( p._core ) );
+                _core.template assign_value< std::remove_cvref_t< U > >( (U&&) v );
                 return *this;
         }
 
@@ -137,27 +130,44 @@ public:
         constexpr _vopt& operator=( _vopt< Us... >&& p ) noexcept(
             core_type::template is_nothrow_assignable< typename _vopt< Us... >::core_type&& > )
         {
-                // XXX not null friendly
                 _core.assign( std::move( p._core ) );
                 return *this;
         }
 
-        constexpr _vopt& operator=( _vopt const& p ) noexcept(
-            core_type::template is_nothrow_assignable< typename _vopt::core_type const& > )
+        template < typename... Us >
+                requires( vconvertible_to< typelist< Us... >, types > )
+        constexpr _vopt& operator=( _vopt< Us... > const& p ) noexcept(
+            core_type::template is_nothrow_assignable< typename _vopt< Us... >::core_type const& > )
         {
-                // XXX not null friendly
                 _core.assign( p._core );
                 return *this;
         }
 
+        /// Assignment with strong exception guarantee: the new value is constructed in temporary
+        /// storage and swapped in, so the current value is kept if the construction throws. The
+        /// assignment operators instead reuse the current value if it has the same type and
+        /// construct directly in place if that can't throw.
+        template < typename U >
+                requires( vconvertible_type< std::remove_cvref_t< U >, types > )
+        constexpr void assign_strong( U&& v )
+        {
+                _core.template assign_value_strong< std::remove_cvref_t< U > >( (U&&) v );
+        }
+
+        /// Assignment with strong exception guarantee from compatible `vopt`.
         template < typename... Us >
                 requires( vconvertible_to< typelist< Us... >, types > )
-        constexpr _vopt& operator=( _vopt< Us... > const& p ) noexcept(
-            core_type::template is_nothrow_assignable< typename _vopt< Us... >::core_type const& > )
+        constexpr void assign_strong( _vopt< Us... > const& p )
         {
-                // XXX not null friendly
-                _core.assign( p._core );
-                return *this;
+                _core.assign_strong( p._core );
+        }
+
+        /// Assignment with strong exception guarantee from compatible `vopt`.
+        template < typename... Us >
+                requires( vconvertible_to< typelist< Us... >, types > )
+        constexpr void assign_strong( _vopt< Us... >&& p )
+        {
+                _core.assign_strong( std::move( p._core ) );
         }
 
         template < typename T, typename... Args >
@@ -165,14 +175,27 @@ public:
         constexpr T&
         emplace( Args&&... args ) noexcept( std::is_nothrow_constructible_v< T, Args... > )
         {
-                if ( _core.index != null_index )
+                if ( _core.get_index() != null_index )
                         _core.destroy();
                 return _core.template emplace< T >( (Args&&) args... );
         }
 
         [[nodiscard]] constexpr index_type index() const noexcept
         {
-                return _core.index;
+                return _core.get_index();
+        }
+
+        /// Moves the value into `V`, a `vopt` over a superset of the types. The value is relocated:
+        /// if the types are trivially relocatable, the bytes of the storage and the index are
+        /// copied without any dispatch, otherwise the value is move constructed and the source
+        /// destroyed. This `vopt` is left empty.
+        template < typename V >
+                requires( _is_vopt< V > && vconvertible_to< types, typename V::types > )
+        constexpr V widen() && noexcept( V::core_type::template nothrow_relocatable_from< types > )
+        {
+                V res;
+                res._core.relocate_from( _core );
+                return res;
         }
 
         constexpr auto& operator*() const noexcept
@@ -191,7 +214,7 @@ public:
                 requires( vconvertible_to< types, typelist< Us... > > )
         constexpr operator _vptr< Us... >() & noexcept
         {
-                if ( _core.index == null_index )
+                if ( _core.get_index() == null_index )
                         return _vptr< Us... >{};
                 return core_type::visit_impl( _core, [&]( auto& item ) {
                         return _vptr< Us... >( &item );
@@ -203,7 +226,7 @@ public:
         constexpr operator _vptr< Us... >() const& noexcept
         {
                 static_assert( all_is_const_v< typelist< Us... > > );
-                if ( _core.index == null_index )
+                if ( _core.get_index() == null_index )
                         return _vptr< Us... >{};
                 return core_type::visit_impl( _core, [&]( auto& item ) {
                         return _vptr< Us... >( &item );
@@ -212,7 +235,7 @@ public:
 
         constexpr explicit operator bool() const noexcept
         {
-                return _core.index != null_index;
+                return _core.get_index() != null_index;
         }
 
         constexpr reference vref() & noexcept
@@ -248,26 +271,26 @@ public:
                 return res;
         }
 
-        template < typename... Fs >
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit( Fs&&... f ) const
         {
                 typename _check_unique_invocability< types >::template with_nullable_pure_cref<
                     Fs... >
                     _{};
-                if ( _core.index == null_index )
+                if ( _core.get_index() == null_index )
                         return _dispatch_fun( empty, (Fs&&) f... );
-                return core_type::visit_impl( _core, (Fs&&) f... );
+                return core_type::template visit_impl< S >( _core, (Fs&&) f... );
         }
 
-        template < typename... Fs >
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit( Fs&&... f )
         {
                 typename _check_unique_invocability< types >::template with_nullable_pure_ref<
                     Fs... >
                     _{};
-                if ( _core.index == null_index )
+                if ( _core.get_index() == null_index )
                         return _dispatch_fun( empty, (Fs&&) f... );
-                return core_type::visit_impl( _core, (Fs&&) f... );
+                return core_type::template visit_impl< S >( _core, (Fs&&) f... );
         }
 
         constexpr friend void
@@ -277,32 +300,31 @@ public:
                 swap( lh._core, rh._core );
         }
 
-        constexpr ~_vopt() noexcept( std::is_nothrow_destructible_v< core_type > )
-        {
-                if ( _core.index != null_index )
-                        _core.destroy();
-        }
-
         friend constexpr std::partial_ordering operator<=>(
             _vopt const& lh,
             _vopt const& rh ) noexcept( all_nothrow_three_way_comparable_v< types > )
         {
-                if ( lh._core.index == null_index || rh._core.index == null_index )
-                        return lh._core.index <=> rh._core.index;
+                if ( lh._core.get_index() == null_index || rh._core.get_index() == null_index )
+                        return lh._core.get_index() <=> rh._core.get_index();
                 return core_type::three_way_compare( lh._core, rh._core );
         };
 
         friend constexpr auto operator==( _vopt const& lh, _vopt const& rh ) noexcept(
             all_nothrow_equality_comparable_v< types > )
         {
-                if ( lh._core.index == null_index || rh._core.index == null_index )
-                        return lh._core.index == rh._core.index;
+                if ( lh._core.get_index() == null_index || rh._core.get_index() == null_index )
+                        return lh._core.get_index() == rh._core.get_index();
                 return core_type::compare( lh._core, rh._core );
         };
 
 private:
         template < typename... Us >
         friend class _vopt;
+        template < typename... Us >
+        friend class _vval;
+        template < typename T >
+        friend struct _visit_operand;
+        friend struct std::hash< _vopt >;
 
         core_type _core;
 };
@@ -310,4 +332,21 @@ private:
 template < typename... Ts >
 using vopt = _define_variadic< _vopt, typelist< Ts... > >;
 
+template < typename... Ts >
+struct is_trivially_relocatable< _vopt< Ts... > >
+  : std::bool_constant< _all_trivially_relocatable_v< typelist< Ts... > > >
+{
+};
+
 }  // namespace vari
+
+/// Hash of the stored value mixed with its index. Empty `vopt` has hash of its own.
+template < typename... Ts >
+        requires( vari::_item_hashable< std::remove_const_t< Ts > > && ... )
+struct std::hash< vari::_vopt< Ts... > >
+{
+        std::size_t operator()( vari::_vopt< Ts... > const& v ) const
+        {
+                return vari::_val_core< vari::typelist< Ts... > >::hash( v._core );
+        }
+};
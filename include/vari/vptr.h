@@ -90,21 +90,21 @@ public:
         /// or `void&` otherwise. Undefined behavior on null pointer.
         constexpr auto& operator*() const noexcept
         {
-                return *_core.ptr;
+                return *_core.get_ptr();
         }
 
         /// Provides member access to the pointed-to type. It is `T*` if there is only one type in
         /// `Ts...`, or `void*` otherwise. Undefined behavior on null pointer.
         constexpr auto* operator->() const noexcept
         {
-                return _core.ptr;
+                return _core.get_ptr();
         }
 
         /// Returns a pointer to the pointed-to type. It is `T*` if there is only one type in
         /// `Ts...`, or `void*` otherwise. Can be null.
         constexpr auto* get() const noexcept
         {
-                return _core.ptr;
+                return _core.get_ptr();
         }
 
         /// Returns the index representing the type currently being pointed-to.
@@ -119,14 +119,14 @@ public:
         ///
         constexpr explicit operator bool() const noexcept
         {
-                return _core.ptr != nullptr;
+                return _core.get_ptr() != nullptr;
         }
 
         /// Constructs a variadic reference that points to the same target as this pointer.
         /// Undefined behavior if the pointer is null.
         constexpr reference vref() const noexcept
         {
-                VARI_ASSERT( _core.ptr );
+                VARI_ASSERT( _core.get_ptr() );
 
                 reference r;
                 r._core = _core;
@@ -135,15 +135,16 @@ public:
 
         /// Calls the appropriate function from the list `fs...`, based on the type of the current
         /// target, or one with `empty_t` in case of null pointer.
-        template < typename... Fs >
+        /// `S` selects how is the type dispatched, see `dispatch_strategy`.
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit( Fs&&... fs ) const
         {
                 typename _check_unique_invocability< types >::template with_nullable_pure_ref<
                     Fs... >
                     _{};
-                if ( _core.ptr == nullptr )
+                if ( _core.get_ptr() == nullptr )
                         return _dispatch_fun( empty, (Fs&&) fs... );
-                return _core.visit_impl( (Fs&&) fs... );
+                return _core.template visit_impl< S >( (Fs&&) fs... );
         }
 
 
@@ -165,6 +166,10 @@ private:
         friend class _uvref;
         template < typename Deleter, typename... Us >
         friend class _uvptr;
+        template < typename T >
+        friend struct _visit_operand;
+        template < typename... Us >
+        friend class _vptr_array;
 };
 
 /// Compares the internal pointers of both pointers.
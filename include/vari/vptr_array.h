@@ -0,0 +1,187 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/assert.h"
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+#include "vari/concept.h"
+#include "vari/forward.h"
+#include "vari/index_kernels.h"
+#include "vari/vptr.h"
+#include "vari/vref.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace vari
+{
+
+/// Sequence of variadic pointers to `Ts...`, stored as two parallel arrays: one of indexes and one
+/// of pointers. Indexes are narrowed to `_index_storage_t`, so for up to 255 types one byte each,
+/// and null is stored as the maximum of that type. Passes that only need the types of the
+/// elements scan just the dense index array, using the vectorized kernels of `index_kernels.h`.
+template < typename... Ts >
+class _vptr_array
+{
+public:
+        using types         = typelist< Ts... >;
+        using pointer       = _vptr< Ts... >;
+        using reference     = _vref< Ts... >;
+        using index_storage = _index_storage_t< sizeof...( Ts ) >;
+
+        static constexpr index_storage null_value = static_cast< index_storage >( null_index );
+
+        constexpr _vptr_array() = default;
+
+        template < typename... Us >
+                requires( vconvertible_to< typelist< Us... >, types > )
+        constexpr void push_back( _vptr< Us... > const& p )
+        {
+                pointer const q = p;
+                _ptrs.push_back( _to_void_cast( q._core.get_ptr() ) );
+                _ixs.push_back( static_cast< index_storage >( q._core.get_index() ) );
+        }
+
+        template < typename U >
+                requires( vconvertible_to< typelist< U >, types > )
+        constexpr void push_back( U& u )
+        {
+                push_back( pointer( &u ) );
+        }
+
+        constexpr void pop_back() noexcept
+        {
+                _ptrs.pop_back();
+                _ixs.pop_back();
+        }
+
+        /// Pointer stored at position `i`.
+        [[nodiscard]] constexpr pointer operator[]( std::size_t i ) const noexcept
+        {
+                VARI_ASSERT( i < size() );
+                pointer res;
+                if ( _ixs[i] != null_value )
+                        res._core.set_raw( _ixs[i], _ptrs[i] );
+                return res;
+        }
+
+        /// Reference stored at position `i`, undefined behavior if it is null.
+        [[nodiscard]] constexpr reference ref( std::size_t i ) const noexcept
+        {
+                return ( *this )[i].vref();
+        }
+
+        template < typename... Us >
+                requires( vconvertible_to< typelist< Us... >, types > )
+        constexpr void set( std::size_t i, _vptr< Us... > const& p ) noexcept
+        {
+                VARI_ASSERT( i < size() );
+                pointer const q = p;
+                _ptrs[i]        = _to_void_cast( q._core.get_ptr() );
+                _ixs[i]         = static_cast< index_storage >( q._core.get_index() );
+        }
+
+        /// Index of the type at position `i`, `null_index` if the pointer is null.
+        [[nodiscard]] constexpr index_type index( std::size_t i ) const noexcept
+        {
+                VARI_ASSERT( i < size() );
+                return _ixs[i] == null_value ? null_index : _ixs[i];
+        }
+
+        /// Dense array of the indexes, null is `null_value`.
+        [[nodiscard]] constexpr std::span< index_storage const > indexes() const noexcept
+        {
+                return _ixs;
+        }
+
+        [[nodiscard]] constexpr std::span< void* const > pointers() const noexcept
+        {
+                return _ptrs;
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        {
+                return _ixs.size();
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+                return _ixs.empty();
+        }
+
+        constexpr void reserve( std::size_t n )
+        {
+                _ptrs.reserve( n );
+                _ixs.reserve( n );
+        }
+
+        constexpr void clear() noexcept
+        {
+                _ptrs.clear();
+                _ixs.clear();
+        }
+
+        /// Number of elements of each type, the last item is the number of nulls.
+        [[nodiscard]] std::array< std::size_t, sizeof...( Ts ) + 1 > counts() const noexcept
+        {
+                return index_histogram< types >( indexes() );
+        }
+
+        /// Number of elements pointing to any of the types `Us...`.
+        template < typename... Us >
+        [[nodiscard]] std::size_t count() const noexcept
+        {
+                return match_count< types, Us... >( indexes() );
+        }
+
+        /// Position of the first element from `from` pointing to any of the types `Us...`, or
+        /// `size()` if there is none.
+        template < typename... Us >
+        [[nodiscard]] std::size_t find_first( std::size_t from = 0 ) const noexcept
+        {
+                return match_find_first< types, Us... >( indexes(), from );
+        }
+
+        /// Writes positions of all elements pointing to any of the types `Us...` into `out`.
+        template < typename... Us, typename OutIt >
+        OutIt filter( OutIt out ) const
+        {
+                return match_positions< types, Us... >( indexes(), out );
+        }
+
+private:
+        std::vector< void* >         _ptrs;
+        std::vector< index_storage > _ixs;
+};
+
+/// Split index/pointer array of variadic pointers to `Ts...`, see `_vptr_array`. Types are
+/// flattened and deduplicated the same way as for other variadics.
+template < typename... Ts >
+using vptr_array = _define_variadic< _vptr_array, typelist< Ts... > >;
+
+}  // namespace vari
@@ -65,21 +65,21 @@ public:
         /// or `void&` otherwise.
         constexpr auto& operator*() const noexcept
         {
-                return *_core.ptr;
+                return *_core.get_ptr();
         }
 
         /// Provides member access to the pointed-to type. It is `T*` if there is only one type in
         /// `Ts...`, or `void*` otherwise.
         constexpr auto* operator->() const noexcept
         {
-                return _core.ptr;
+                return _core.get_ptr();
         }
 
         /// Returns a pointer to the pointed-to type. It is `T*` if there is only one type in
         /// `Ts...`, or `void*` otherwise.
         constexpr auto* get() const noexcept
         {
-                return _core.ptr;
+                return _core.get_ptr();
         }
 
         /// Returns the index representing the type currently being referenced.
@@ -95,7 +95,7 @@ public:
                 requires( vconvertible_to< types, typelist< U > > )
         constexpr operator U&() const noexcept
         {
-                return *_core.ptr;
+                return *_core.get_ptr();
         }
 
         /// Constructs a variadic pointer that points to the same target as the current reference.
@@ -109,12 +109,13 @@ public:
 
         /// Calls the appropriate function from the list `fs...`, based on the type of the current
         /// target.
-        template < typename... Fs >
+        /// `S` selects how is the type dispatched, see `dispatch_strategy`.
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit( Fs&&... fs ) const
         {
                 typename _check_unique_invocability< types >::template with_pure_ref< Fs... > _{};
-                VARI_ASSERT( _core.ptr );
-                return _core.visit_impl( (Fs&&) fs... );
+                VARI_ASSERT( _core.get_ptr() );
+                return _core.template visit_impl< S >( (Fs&&) fs... );
         }
 
         /// Swaps the current reference with another one.
@@ -137,6 +138,8 @@ private:
         friend class _uvref;
         template < typename Deleter, typename... Us >
         friend class _uvptr;
+        template < typename T >
+        friend struct _visit_operand;
 };
 
 /// Compares the internal pointers of both references.
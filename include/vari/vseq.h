@@ -0,0 +1,395 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/dispatch.h"
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+#include "vari/forward.h"
+#include "vari/relocate.h"
+#include "vari/vref.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+
+namespace vari
+{
+
+/// Append-only sequence of objects of any of the types `Ts...`, stored in order in one contiguous
+/// byte buffer. Each record is a compact header with the index of the type, followed by the
+/// object aligned for its type. Record takes only as much space as its own type needs, unlike
+/// `vval` sized by the largest type.
+///
+/// Iteration yields `vref` to the objects. Growing the buffer relocates the objects, which
+/// invalidates all references into the sequence, so all `Ts...` have to be nothrow relocatable.
+template < typename... Ts >
+class _vseq
+{
+        static_assert( ( ( !std::is_const_v< Ts > && !std::is_reference_v< Ts > ) && ... ) );
+        static_assert(
+            ( _nothrow_relocatable_v< Ts > && ... ),
+            "Objects are relocated when the buffer grows" );
+
+        using header_type = _index_storage_t< sizeof...( Ts ) >;
+
+        static constexpr std::size_t align =
+            std::max( { alignof( header_type ), alignof( Ts )... } );
+        static constexpr std::size_t sizes[]  = { sizeof( Ts )... };
+        static constexpr std::size_t aligns[] = { alignof( Ts )... };
+
+        template < bool Const >
+        class _iterator;
+
+public:
+        using types           = typelist< Ts... >;
+        using reference       = _vref< Ts... >;
+        using const_reference = _vref< Ts const... >;
+        using iterator        = _iterator< false >;
+        using const_iterator  = _iterator< true >;
+
+        _vseq() noexcept = default;
+
+        _vseq( _vseq const& )            = delete;
+        _vseq& operator=( _vseq const& ) = delete;
+
+        _vseq( _vseq&& other ) noexcept
+          : _buf( std::exchange( other._buf, nullptr ) )
+          , _cap( std::exchange( other._cap, 0 ) )
+          , _end( std::exchange( other._end, 0 ) )
+          , _count( std::exchange( other._count, 0 ) )
+        {
+        }
+
+        _vseq& operator=( _vseq&& other ) noexcept
+        {
+                _vseq tmp{ std::move( other ) };
+                swap( *this, tmp );
+                return *this;
+        }
+
+        friend void swap( _vseq& lh, _vseq& rh ) noexcept
+        {
+                std::swap( lh._buf, rh._buf );
+                std::swap( lh._cap, rh._cap );
+                std::swap( lh._end, rh._end );
+                std::swap( lh._count, rh._count );
+        }
+
+        ~_vseq()
+        {
+                clear();
+                _deallocate( _buf, _cap );
+        }
+
+        /// Constructs an object of type `T` at the end of the sequence.
+        template < typename T, typename... Args >
+                requires( contains_type_v< T, types > && std::constructible_from< T, Args... > )
+        T& emplace( Args&&... args )
+        {
+                static constexpr index_type i = index_of_t_or_const_t_v< T, types >;
+
+                std::size_t const obj  = _obj_offset( _end, i );
+                std::size_t const next = _next_offset( _end, i );
+                T*                res  = nullptr;
+                if ( next > _cap ) {
+                        // `args` may refer to objects in the sequence, so the new object is
+                        // constructed in the new buffer before the old ones are relocated. If the
+                        // construction throws, the new buffer is freed and the sequence is intact.
+                        _buffer nb{ nullptr, _grown_capacity( next ) };
+                        nb.buf = _allocate( nb.cap );
+                        res    = std::construct_at(
+                            reinterpret_cast< T* >( nb.buf + obj ), (Args&&) args... );
+                        _relocate_into( nb.buf );
+                        std::swap( _buf, nb.buf );
+                        std::swap( _cap, nb.cap );
+                } else {
+                        res = std::construct_at(
+                            reinterpret_cast< T* >( _buf + obj ), (Args&&) args... );
+                }
+                header_type const h = static_cast< header_type >( i );
+                std::memcpy( _buf + _end, &h, sizeof( header_type ) );
+                _end = next;
+                _count += 1;
+                return *res;
+        }
+
+        /// Appends `u` at the end of the sequence.
+        template < typename U >
+                requires( contains_type_v< std::remove_cvref_t< U >, types > )
+        std::remove_cvref_t< U >& push_back( U&& u )
+        {
+                return emplace< std::remove_cvref_t< U > >( (U&&) u );
+        }
+
+        /// Number of objects in the sequence.
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+                return _count;
+        }
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+                return _count == 0;
+        }
+
+        /// Number of bytes used by the records.
+        [[nodiscard]] std::size_t bytes() const noexcept
+        {
+                return _end;
+        }
+
+        [[nodiscard]] std::size_t capacity_bytes() const noexcept
+        {
+                return _cap;
+        }
+
+        void reserve_bytes( std::size_t n )
+        {
+                if ( n > _cap )
+                        _grow( n );
+        }
+
+        void clear() noexcept
+        {
+                if constexpr ( !( std::is_trivially_destructible_v< Ts > && ... ) )
+                        _walk( _buf, _end, [&]< index_type j >( std::size_t, auto* p ) {
+                                std::destroy_at( p );
+                        } );
+                _end   = 0;
+                _count = 0;
+        }
+
+        [[nodiscard]] iterator begin() noexcept
+        {
+                return iterator{ _buf, 0 };
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+                return iterator{ _buf, _end };
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+                return const_iterator{ _buf, 0 };
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+                return const_iterator{ _buf, _end };
+        }
+
+        /// Calls the one callable out of `fs...` invocable with `T&` for each object, in order.
+        /// Each record is dispatched directly into the callable, without creating a `vref`.
+        template < typename... Fs >
+        void for_each( Fs&&... fs )
+        {
+                typename _check_unique_invocability< types >::template with_pure_ref< Fs&... > _{};
+                _walk( _buf, _end, [&]< index_type j >( std::size_t, auto* p ) {
+                        _function_picker< type_at_t< j, types >& >::pick( fs... )( *p );
+                } );
+        }
+
+        template < typename... Fs >
+        void for_each( Fs&&... fs ) const
+        {
+                typename _check_unique_invocability< types >::template with_pure_cref< Fs&... >
+                    _{};
+                _walk( _buf, _end, [&]< index_type j >( std::size_t, auto* p ) {
+                        _function_picker< type_at_t< j, types > const& >::pick( fs... )( *p );
+                } );
+        }
+
+private:
+        static constexpr std::size_t _align_up( std::size_t x, std::size_t a ) noexcept
+        {
+                return ( x + a - 1 ) & ~( a - 1 );
+        }
+
+        // Offset of the object of record with index `i` that starts at `off`.
+        static constexpr std::size_t _obj_offset( std::size_t off, index_type i ) noexcept
+        {
+                return _align_up( off + sizeof( header_type ), aligns[i] );
+        }
+
+        // Offset of the record following record with index `i` that starts at `off`.
+        static constexpr std::size_t _next_offset( std::size_t off, index_type i ) noexcept
+        {
+                return _align_up( _obj_offset( off, i ) + sizes[i], alignof( header_type ) );
+        }
+
+        static index_type _index_at( std::byte const* buf, std::size_t off ) noexcept
+        {
+                header_type h;
+                std::memcpy( &h, buf + off, sizeof( header_type ) );
+                return h;
+        }
+
+        // Calls `f.template operator()< j >( off, p )` for each record, with `p` pointing to the
+        // object of type `j` of the record at `off`.
+        template < typename B, typename F >
+        static void _walk( B* buf, std::size_t end, F&& f )
+        {
+                for ( std::size_t off = 0; off < end; ) {
+                        index_type const i = _index_at( buf, off );
+                        _dispatch_index< 0, sizeof...( Ts ) >( i, [&]< index_type j >() {
+                                using T = std::conditional_t<
+                                    std::is_const_v< B >,
+                                    type_at_t< j, types > const,
+                                    type_at_t< j, types > >;
+                                f.template operator()< j >(
+                                    off,
+                                    std::launder(
+                                        reinterpret_cast< T* >( buf + _obj_offset( off, i ) ) ) );
+                        } );
+                        off = _next_offset( off, i );
+                }
+        }
+
+        static std::byte* _allocate( std::size_t n )
+        {
+                return static_cast< std::byte* >( ::operator new( n, std::align_val_t{ align } ) );
+        }
+
+        static void _deallocate( std::byte* p, std::size_t n ) noexcept
+        {
+                if ( p != nullptr )
+                        ::operator delete( p, n, std::align_val_t{ align } );
+        }
+
+        // Owns a buffer until it is swapped into the sequence.
+        struct _buffer
+        {
+                std::byte*  buf;
+                std::size_t cap;
+
+                ~_buffer()
+                {
+                        _deallocate( buf, cap );
+                }
+        };
+
+        std::size_t _grown_capacity( std::size_t min_cap ) const noexcept
+        {
+                return std::max( { min_cap, 2 * _cap, std::size_t{ 64 } } );
+        }
+
+        void _grow( std::size_t min_cap )
+        {
+                _buffer nb{ nullptr, _grown_capacity( min_cap ) };
+                nb.buf = _allocate( nb.cap );
+                _relocate_into( nb.buf );
+                std::swap( _buf, nb.buf );
+                std::swap( _cap, nb.cap );
+        }
+
+        // The buffer is aligned for all the types, so every record keeps its offset in the new
+        // buffer and the objects are relocated one by one, or all at once if that is bytewise.
+        void _relocate_into( std::byte* buf ) noexcept
+        {
+                if constexpr ( _all_trivially_relocatable_v< types > ) {
+                        if ( _end != 0 )
+                                std::memcpy( buf, _buf, _end );
+                } else {
+                        _walk( _buf, _end, [&]< index_type j >( std::size_t off, auto* p ) {
+                                std::memcpy( buf + off, _buf + off, sizeof( header_type ) );
+                                relocate_at(
+                                    p,
+                                    reinterpret_cast< type_at_t< j, types >* >(
+                                        buf + _obj_offset( off, j ) ) );
+                        } );
+                }
+        }
+
+        std::byte*  _buf   = nullptr;
+        std::size_t _cap   = 0;
+        std::size_t _end   = 0;
+        std::size_t _count = 0;
+};
+
+template < typename... Ts >
+template < bool Const >
+class _vseq< Ts... >::_iterator
+{
+        using byte_type = std::conditional_t< Const, std::byte const, std::byte >;
+
+public:
+        using value_type      = std::conditional_t< Const, _vref< Ts const... >, _vref< Ts... > >;
+        using difference_type = std::ptrdiff_t;
+
+        _iterator() noexcept = default;
+
+        _iterator( byte_type* buf, std::size_t off ) noexcept
+          : _buf( buf )
+          , _off( off )
+        {
+        }
+
+        value_type operator*() const noexcept
+        {
+                index_type const i = _index_at( _buf, _off );
+                return _dispatch_index< 0, sizeof...( Ts ) >(
+                    i, [&]< index_type j >() -> value_type {
+                            using T = std::conditional_t<
+                                Const,
+                                type_at_t< j, types > const,
+                                type_at_t< j, types > >;
+                            return value_type( *std::launder(
+                                reinterpret_cast< T* >( _buf + _obj_offset( _off, i ) ) ) );
+                    } );
+        }
+
+        _iterator& operator++() noexcept
+        {
+                _off = _next_offset( _off, _index_at( _buf, _off ) );
+                return *this;
+        }
+
+        _iterator operator++( int ) noexcept
+        {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+        }
+
+        friend bool operator==( _iterator const& lh, _iterator const& rh ) noexcept
+        {
+                return lh._off == rh._off;
+        }
+
+private:
+        byte_type*  _buf = nullptr;
+        std::size_t _off = 0;
+};
+
+/// Packed sequence of objects of types `Ts...`, see `_vseq`. Types are flattened and deduplicated
+/// the same way as for other variadics.
+template < typename... Ts >
+using vseq = _define_variadic< _vseq, typelist< Ts... > >;
+
+}  // namespace vari
@@ -29,6 +29,9 @@
 #include "vari/vptr.h"
 #include "vari/vref.h"
 
+#include <cstddef>
+#include <functional>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -37,6 +40,15 @@
 namespace vari
 {
 
+template < typename T >
+static constexpr bool _is_val_variadic = false;
+
+template < typename... Ts >
+static constexpr bool _is_val_variadic< _vval< Ts... > > = true;
+
+template < typename... Ts >
+static constexpr bool _is_val_variadic< _vopt< Ts... > > = true;
+
 // WARNING: experimental
 template < typename... Ts >
 class _vval
@@ -65,10 +77,12 @@ public:
                 _core.template emplace< U >( (Args&&) args... );
         }
 
-        constexpr _vval( _vval&& p ) noexcept( std::is_nothrow_move_constructible_v< core_type > )
-          : _core( std::move( p._core ) )
-        {
-        }
+        // Defaulted, so these are trivial whenever the same member of the core is trivial.
+        constexpr _vval( _vval&& )                 = default;
+        constexpr _vval( _vval const& )            = default;
+        constexpr _vval& operator=( _vval&& )      = default;
+        constexpr _vval& operator=( _vval const& ) = default;
+        constexpr ~_vval()                         = default;
 
         template < typename... Us >
                 requires( vconvertible_to< typelist< Us... >, types > )
@@ -78,12 +92,6 @@ public:
         {
         }
 
-        constexpr _vval( _vval const& p ) noexcept(
-            std::is_nothrow_copy_constructible_v< core_type > )
-          : _core( p._core )
-        {
-        }
-
         template < typename... Us >
                 requires( vconvertible_to< typelist< Us... >, types > )
         constexpr _vval( _vval< Us... > const& p ) noexcept(
@@ -95,18 +103,10 @@ public:
 
         template < typename U >
                 requires( vconvertible_type< std::remove_cvref_t< U >, types > )
-        constexpr _vval& operator=( U&& v ) noexcept( _forward_nothrow_constructible< U > )
+        constexpr _vval& operator=( U&& v ) noexcept(
+            core_type::template is_nothrow_value_assignable< std::remove_cvref_t< U >, U > )
         {
-                if ( _core.index != null_index )
-                        _core.destroy();
-                _core.template emplace< std::remove_cvref_t< U > >( (U&&) v );
-                return *this;
-        }
-
-        constexpr _vval& operator=( _vval&& p ) noexcept(
-            core_type::template is_nothrow_assignable< typename _vval::core_type&& > )
-        {
-                _core.assign( std::move( p._core ) );
+                _core.template assign_value< std::remove_cvref_t< U > >( (U&&) v );
                 return *this;
         }
 
@@ -119,20 +119,40 @@ public:
                 return *this;
         }
 
-        constexpr _vval& operator=( _vval const& p ) noexcept(
-            core_type::template is_nothrow_assignable< typename _vval::core_type const& > )
+        template < typename... Us >
+                requires( vconvertible_to< typelist< Us... >, types > )
+        constexpr _vval& operator=( _vval< Us... > const& p ) noexcept(
+            core_type::template is_nothrow_assignable< typename _vval< Us... >::core_type const& > )
         {
                 _core.assign( p._core );
                 return *this;
         }
 
+        /// Assignment with strong exception guarantee: the new value is constructed in temporary
+        /// storage and swapped in, so the current value is kept if the construction throws. The
+        /// assignment operators instead reuse the current value if it has the same type and
+        /// construct directly in place if that can't throw.
+        template < typename U >
+                requires( vconvertible_type< std::remove_cvref_t< U >, types > )
+        constexpr void assign_strong( U&& v )
+        {
+                _core.template assign_value_strong< std::remove_cvref_t< U > >( (U&&) v );
+        }
+
+        /// Assignment with strong exception guarantee from compatible `vval`.
         template < typename... Us >
                 requires( vconvertible_to< typelist< Us... >, types > )
-        constexpr _vval& operator=( _vval< Us... > const& p ) noexcept(
-            core_type::template is_nothrow_assignable< typename _vval< Us... >::core_type const& > )
+        constexpr void assign_strong( _vval< Us... > const& p )
         {
-                _core.assign( p._core );
-                return *this;
+                _core.assign_strong( p._core );
+        }
+
+        /// Assignment with strong exception guarantee from compatible `vval`.
+        template < typename... Us >
+                requires( vconvertible_to< typelist< Us... >, types > )
+        constexpr void assign_strong( _vval< Us... >&& p )
+        {
+                _core.assign_strong( std::move( p._core ) );
         }
 
         template < typename T, typename... Args >
@@ -146,7 +166,21 @@ public:
 
         [[nodiscard]] constexpr index_type index() const noexcept
         {
-                return _core.index;
+                return _core.get_index();
+        }
+
+        /// Moves the value into `V`, a `vval` or `vopt` over a superset of the types. The value is
+        /// relocated: if the types are trivially relocatable, the bytes of the storage and the
+        /// index are copied without any dispatch, otherwise the value is move constructed and the
+        /// source destroyed. This `vval` is left without value, it shall only be destroyed or
+        /// assigned to.
+        template < typename V >
+                requires( _is_val_variadic< V > && vconvertible_to< types, typename V::types > )
+        constexpr V widen() && noexcept( V::core_type::template nothrow_relocatable_from< types > )
+        {
+                V res;
+                res._core.relocate_from( _core );
+                return res;
         }
 
         constexpr auto& operator*() const noexcept
@@ -200,18 +234,18 @@ public:
                 return const_reference{ *this }.vptr();
         }
 
-        template < typename... Fs >
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit( Fs&&... f ) const
         {
                 typename _check_unique_invocability< types >::template with_pure_cref< Fs... > _{};
-                return core_type::visit_impl( _core, (Fs&&) f... );
+                return core_type::template visit_impl< S >( _core, (Fs&&) f... );
         }
 
-        template < typename... Fs >
+        template < dispatch_strategy S = default_dispatch_strategy, typename... Fs >
         constexpr decltype( auto ) visit( Fs&&... f )
         {
                 typename _check_unique_invocability< types >::template with_pure_ref< Fs... > _{};
-                return core_type::visit_impl( _core, (Fs&&) f... );
+                return core_type::template visit_impl< S >( _core, (Fs&&) f... );
         }
 
         constexpr friend void
@@ -220,11 +254,6 @@ public:
                 swap( lh._core, rh._core );
         }
 
-        constexpr ~_vval() noexcept( std::is_nothrow_destructible_v< core_type > )
-        {
-                _core.destroy();
-        }
-
         friend constexpr auto operator<=>( _vval const& lh, _vval const& rh ) noexcept(
             all_nothrow_three_way_comparable_v< types > )
         {
@@ -246,9 +275,67 @@ private:
         friend class _vval;
         template < typename... Us >
         friend class _vopt;
+        template < typename T >
+        friend struct _visit_operand;
+        friend struct std::hash< _vval >;
 };
 
 template < typename... Ts >
 using vval = _define_variadic< _vval, typelist< Ts... > >;
 
+template < typename... Ts >
+struct is_trivially_relocatable< _vval< Ts... > >
+  : std::bool_constant< _all_trivially_relocatable_v< typelist< Ts... > > >
+{
+};
+
+}  // namespace vari
+
+/// Hash of the stored value mixed with its index.
+template < typename... Ts >
+        requires( vari::_item_hashable< std::remove_const_t< Ts > > && ... )
+struct std::hash< vari::_vval< Ts... > >
+{
+        std::size_t operator()( vari::_vval< Ts... > const& v ) const
+        {
+                return vari::_val_core< vari::typelist< Ts... > >::hash( v._core );
+        }
+};
+
+namespace vari
+{
+
+/// Compares two ranges of `vval` or `vopt` elementwise, ranges of different size are not equal.
+/// Elements of types that are `is_bytewise_comparable` are compared with `memcmp`, if all types
+/// of the variadic are, the comparison of an element has no dispatch on its type. The range is not
+/// compared by one `memcmp`: bytes of an element past its current item and the padding next to the
+/// index are unspecified.
+template < typename L, std::size_t LE, typename R, std::size_t RE >
+        requires(
+            _is_val_variadic< std::remove_const_t< L > > &&
+            std::same_as< std::remove_const_t< L >, std::remove_const_t< R > > )
+bool equal( std::span< L, LE > lh, std::span< R, RE > rh )
+{
+        if ( lh.size() != rh.size() )
+                return false;
+        for ( std::size_t i = 0; i < lh.size(); i++ )
+                if ( !( lh[i] == rh[i] ) )
+                        return false;
+        return true;
+}
+
+/// Hash of a range of `vval` or `vopt`, combines hashes of all elements in order with the size of
+/// the range. Usable for change detection of whole arrays. Like `equal`, hashes each element on
+/// its own, only the bytes of its current item.
+template < typename V, std::size_t E >
+        requires( _is_val_variadic< std::remove_const_t< V > > )
+std::size_t hash( std::span< V, E > vs )
+{
+        std::hash< std::remove_const_t< V > > h;
+        std::size_t                           seed = vs.size();
+        for ( auto const& v : vs )
+                seed = _hash_combine( seed, h( v ) );
+        return seed;
+}
+
 }  // namespace vari
@@ -0,0 +1,455 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+///
+
+#pragma once
+
+#include "vari/bits/assert.h"
+#include "vari/bits/dispatch.h"
+#include "vari/bits/typelist.h"
+#include "vari/bits/util.h"
+#include "vari/forward.h"
+#include "vari/vptr.h"
+#include "vari/vref.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace vari
+{
+
+template < typename... Ts >
+class _vvector;
+
+/// Objects of type `T` stored in a list of contiguous blocks. Objects never move: once the blocks
+/// are full, a new block is added, sized to double the total capacity. Iteration goes block by
+/// block in the order of insertion.
+template < typename T >
+class _vvector_segment
+{
+        struct _block
+        {
+                T*          data;
+                std::size_t size;
+                std::size_t cap;
+        };
+
+        static constexpr std::size_t _min_block = 16;
+
+        template < bool Const >
+        class _iterator;
+
+public:
+        using value_type     = T;
+        using iterator       = _iterator< false >;
+        using const_iterator = _iterator< true >;
+
+        constexpr _vvector_segment() noexcept = default;
+
+        constexpr _vvector_segment( _vvector_segment const& other )
+        {
+                reserve( other.size() );
+                for ( T const& x : other )
+                        emplace_back( x );
+        }
+
+        constexpr _vvector_segment( _vvector_segment&& other ) noexcept
+          : _blocks( std::move( other._blocks ) )
+          , _cur( std::exchange( other._cur, 0 ) )
+          , _size( std::exchange( other._size, 0 ) )
+          , _cap( std::exchange( other._cap, 0 ) )
+        {
+                other._blocks.clear();
+        }
+
+        constexpr _vvector_segment& operator=( _vvector_segment other ) noexcept
+        {
+                std::swap( _blocks, other._blocks );
+                std::swap( _cur, other._cur );
+                std::swap( _size, other._size );
+                std::swap( _cap, other._cap );
+                return *this;
+        }
+
+        constexpr ~_vvector_segment()
+        {
+                clear();
+                for ( _block& b : _blocks )
+                        std::allocator< T >{}.deallocate( b.data, b.cap );
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        {
+                return _size;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+                return _size == 0;
+        }
+
+        /// Number of objects that fit into the allocated blocks.
+        [[nodiscard]] constexpr std::size_t capacity() const noexcept
+        {
+                return _cap;
+        }
+
+        /// `i`-th object of the segment, found by walking the blocks.
+        [[nodiscard]] constexpr T& operator[]( std::size_t i ) noexcept
+        {
+                return *_find( _blocks, i );
+        }
+
+        [[nodiscard]] constexpr T const& operator[]( std::size_t i ) const noexcept
+        {
+                return *_find( _blocks, i );
+        }
+
+        [[nodiscard]] constexpr iterator begin() noexcept
+        {
+                return iterator{ _blocks.data(), 0 };
+        }
+
+        [[nodiscard]] constexpr iterator end() noexcept
+        {
+                return iterator{ _blocks.data() + _used(), 0 };
+        }
+
+        [[nodiscard]] constexpr const_iterator begin() const noexcept
+        {
+                return const_iterator{ _blocks.data(), 0 };
+        }
+
+        [[nodiscard]] constexpr const_iterator end() const noexcept
+        {
+                return const_iterator{ _blocks.data() + _used(), 0 };
+        }
+
+        /// Calls `f` with `std::span` of each non-empty block, in order.
+        template < typename F >
+        constexpr void for_each_chunk( F&& f )
+        {
+                for ( std::size_t j = 0; j < _used(); j++ )
+                        f( std::span< T >{ _blocks[j].data, _blocks[j].size } );
+        }
+
+        template < typename F >
+        constexpr void for_each_chunk( F&& f ) const
+        {
+                for ( std::size_t j = 0; j < _used(); j++ )
+                        f( std::span< T const >{ _blocks[j].data, _blocks[j].size } );
+        }
+
+private:
+        template < typename... Ts >
+        friend class _vvector;
+
+        template < typename... Args >
+        constexpr T& emplace_back( Args&&... args )
+        {
+                while ( _cur < _blocks.size() && _blocks[_cur].size == _blocks[_cur].cap )
+                        ++_cur;
+                if ( _cur == _blocks.size() )
+                        _add_block( std::max( _min_block, _cap ) );
+                _block& b   = _blocks[_cur];
+                T*      res = std::construct_at( b.data + b.size, (Args&&) args... );
+                b.size += 1;
+                _size += 1;
+                return *res;
+        }
+
+        constexpr void reserve( std::size_t n )
+        {
+                if ( n > _cap )
+                        _add_block( n - _cap );
+        }
+
+        // Destroys the objects and keeps the blocks for reuse.
+        constexpr void clear() noexcept
+        {
+                for ( _block& b : _blocks ) {
+                        std::destroy_n( b.data, b.size );
+                        b.size = 0;
+                }
+                _cur  = 0;
+                _size = 0;
+        }
+
+        constexpr void _add_block( std::size_t n )
+        {
+                _blocks.reserve( _blocks.size() + 1 );
+                _blocks.push_back( _block{ std::allocator< T >{}.allocate( n ), 0, n } );
+                _cap += n;
+        }
+
+        // Blocks before `_cur` are full and blocks after it are empty, so the non-empty blocks
+        // are a prefix.
+        [[nodiscard]] constexpr std::size_t _used() const noexcept
+        {
+                return _cur + ( _cur < _blocks.size() && _blocks[_cur].size != 0 );
+        }
+
+        template < typename Blocks >
+        static constexpr T* _find( Blocks& blocks, std::size_t i ) noexcept
+        {
+                std::size_t j = 0;
+                while ( j < blocks.size() && i >= blocks[j].size )
+                        i -= blocks[j++].size;
+                VARI_ASSERT( j < blocks.size() );
+                return blocks[j].data + i;
+        }
+
+        std::vector< _block > _blocks;
+        std::size_t           _cur  = 0;
+        std::size_t           _size = 0;
+        std::size_t           _cap  = 0;
+};
+
+template < typename T >
+template < bool Const >
+class _vvector_segment< T >::_iterator
+{
+public:
+        using value_type      = T;
+        using difference_type = std::ptrdiff_t;
+        using reference       = std::conditional_t< Const, T const&, T& >;
+
+        constexpr _iterator() noexcept = default;
+
+        constexpr _iterator( _block const* b, std::size_t i ) noexcept
+          : _b( b )
+          , _i( i )
+        {
+        }
+
+        constexpr reference operator*() const noexcept
+        {
+                return _b->data[_i];
+        }
+
+        constexpr _iterator& operator++() noexcept
+        {
+                if ( ++_i == _b->size ) {
+                        ++_b;
+                        _i = 0;
+                }
+                return *this;
+        }
+
+        constexpr _iterator operator++( int ) noexcept
+        {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+        }
+
+        constexpr bool operator==( _iterator const& ) const noexcept = default;
+
+private:
+        _block const* _b = nullptr;
+        std::size_t   _i = 0;
+};
+
+/// Owning container of objects of any of the types `Ts...`. Objects of each type are stored in
+/// their own segment, segments are ordered as `Ts...`. Segment is a list of contiguous blocks,
+/// there is no per-element allocation nor tag, and iteration goes segment by segment and block by
+/// block without any dispatch.
+///
+/// Objects never move, so references, pointers and `vref`s to them stay valid until the object is
+/// removed by `clear` or the container is destroyed, regardless of insertions of any type.
+template < typename... Ts >
+class _vvector
+{
+        static_assert( ( ( !std::is_const_v< Ts > && !std::is_reference_v< Ts > ) && ... ) );
+
+public:
+        using types           = typelist< Ts... >;
+        using reference       = _vref< Ts... >;
+        using const_reference = _vref< Ts const... >;
+        using pointer         = _vptr< Ts... >;
+        using const_pointer   = _vptr< Ts const... >;
+
+        constexpr _vvector() = default;
+
+        /// Constructs an object of type `T` at the end of the segment of `T`.
+        template < typename T, typename... Args >
+                requires( contains_type_v< T, types > && std::constructible_from< T, Args... > )
+        constexpr T& emplace( Args&&... args )
+        {
+                return _seg< T >().emplace_back( (Args&&) args... );
+        }
+
+        /// Inserts `u` at the end of the segment of its type.
+        template < typename U >
+                requires( contains_type_v< std::remove_cvref_t< U >, types > )
+        constexpr std::remove_cvref_t< U >& push_back( U&& u )
+        {
+                return emplace< std::remove_cvref_t< U > >( (U&&) u );
+        }
+
+        /// Segment of all the objects of type `T`, a forward range with indexed access.
+        template < typename T >
+                requires( contains_type_v< T, types > )
+        [[nodiscard]] constexpr _vvector_segment< T >& segment() noexcept
+        {
+                return _seg< T >();
+        }
+
+        template < typename T >
+                requires( contains_type_v< T, types > )
+        [[nodiscard]] constexpr _vvector_segment< T > const& segment() const noexcept
+        {
+                return _seg< T >();
+        }
+
+        /// Ensures that `n` objects of type `T` fit into the segment of `T` without allocation.
+        template < typename T >
+                requires( contains_type_v< T, types > )
+        constexpr void reserve( std::size_t n )
+        {
+                _seg< T >().reserve( n );
+        }
+
+        /// Number of objects of type `T` that fit into the segment of `T` without allocation.
+        template < typename T >
+                requires( contains_type_v< T, types > )
+        [[nodiscard]] constexpr std::size_t capacity() const noexcept
+        {
+                return _seg< T >().capacity();
+        }
+
+        template < typename T >
+                requires( contains_type_v< T, types > )
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        {
+                return _seg< T >().size();
+        }
+
+        [[nodiscard]] constexpr std::size_t size() const noexcept
+        {
+                return ( _seg< Ts >().size() + ... + 0 );
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+                return ( _seg< Ts >().empty() && ... );
+        }
+
+        /// Destroys all objects, the allocated blocks are kept for reuse.
+        constexpr void clear() noexcept
+        {
+                ( _seg< Ts >().clear(), ... );
+        }
+
+        /// Reference to `i`-th object, counting through the segments in order.
+        [[nodiscard]] constexpr reference at( std::size_t i ) noexcept
+        {
+                return _at< reference >( *this, i );
+        }
+
+        [[nodiscard]] constexpr const_reference at( std::size_t i ) const noexcept
+        {
+                return _at< const_reference >( *this, i );
+        }
+
+        /// Pointer to `i`-th object, null if `i` is out of range.
+        [[nodiscard]] constexpr pointer ptr_at( std::size_t i ) noexcept
+        {
+                return i < size() ? pointer( at( i ) ) : pointer{};
+        }
+
+        [[nodiscard]] constexpr const_pointer ptr_at( std::size_t i ) const noexcept
+        {
+                return i < size() ? const_pointer( at( i ) ) : const_pointer{};
+        }
+
+        /// Calls the one callable out of `fs...` invocable with `T&` for each object of type `T`,
+        /// segment by segment.
+        template < typename... Fs >
+        constexpr void for_each( Fs&&... fs )
+        {
+                typename _check_unique_invocability< types >::template with_pure_ref< Fs&... > _{};
+                ( _for_each< Ts >( _seg< Ts >(), fs... ), ... );
+        }
+
+        template < typename... Fs >
+        constexpr void for_each( Fs&&... fs ) const
+        {
+                typename _check_unique_invocability< types >::template with_pure_cref< Fs&... >
+                    _{};
+                ( _for_each< Ts const >( _seg< Ts >(), fs... ), ... );
+        }
+
+private:
+        template < typename T >
+        constexpr _vvector_segment< T >& _seg() noexcept
+        {
+                return std::get< _vvector_segment< T > >( _segs );
+        }
+
+        template < typename T >
+        constexpr _vvector_segment< T > const& _seg() const noexcept
+        {
+                return std::get< _vvector_segment< T > >( _segs );
+        }
+
+        template < typename T, typename S, typename... Fs >
+        static constexpr void _for_each( S& seg, Fs&... fs )
+        {
+                auto& f = _function_picker< T& >::pick( fs... );
+                seg.for_each_chunk( [&]( std::span< T > chunk ) {
+                        for ( T& x : chunk )
+                                f( x );
+                } );
+        }
+
+        template < typename R, typename Self >
+        static constexpr R _at( Self& self, std::size_t i ) noexcept
+        {
+                VARI_ASSERT( i < self.size() );
+                std::array< std::size_t, sizeof...( Ts ) > const sizes{
+                    self.template size< Ts >()... };
+
+                index_type j = 0;
+                while ( i >= sizes[j] )
+                        i -= sizes[j++];
+                return _dispatch_index< 0, sizeof...( Ts ) >( j, [&]< index_type k >() -> R {
+                        using T = type_at_t< k, types >;
+                        return R( self.template _seg< T >()[i] );
+                } );
+        }
+
+        std::tuple< _vvector_segment< Ts >... > _segs;
+};
+
+/// Struct-of-arrays container of objects of types `Ts...`, see `_vvector`. Types are flattened and
+/// deduplicated the same way as for other variadics.
+template < typename... Ts >
+using vvector = _define_variadic< _vvector, typelist< Ts... > >;
+
+}  // namespace vari
@@ -26,16 +26,31 @@ class VPtrCorePrinter(printer_base):
         alternatives = get_template_arg_list(type_list)
         self._typename = val.type
         if len(alternatives) > 1:
-            self._index = int(val['index'])
+            self._index, ptr = self._decode_storage(val['storage'])
         else:
-            self._index = self._null_index if val['ptr'] == 0 else 1
+            ptr = val['ptr']
+            self._index = self._null_index if ptr == 0 else 1
 
         if self._index == self._null_index or self._index >= len(alternatives):
-            self._ptr = val['ptr']
+            self._ptr = ptr
             self._type = None
         else:
             self._type = alternatives[self._index]
-            self._ptr = val['ptr'].cast(self._type.pointer())
+            self._ptr = ptr.cast(self._type.pointer())
+
+    def _decode_storage(self, storage):
+        fields = [f.name for f in storage.type.strip_typedefs().fields()]
+        if 'index' in fields:
+            return int(storage['index']), storage['ptr']
+        # Trailing arguments, such as whether the store is checked, do not affect the decoding
+        args = get_template_arg_list(storage.type.strip_typedefs())
+        shift, mask = int(args[0]), int(args[1])
+        bits = int(storage['bits'])
+        void_ptr = gdb.lookup_type("void").pointer()
+        if bits == 0:
+            return self._null_index, gdb.Value(0).cast(void_ptr)
+        ptr = gdb.Value(bits & ~mask & (2 ** 64 - 1)).cast(void_ptr)
+        return (bits & mask) >> shift, ptr
 
     def to_string(self):
         return str(self._typename)
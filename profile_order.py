@@ -0,0 +1,101 @@
+import argparse
+import sys
+
+parser = argparse.ArgumentParser(
+    description="Generates typelist_order specializations from profiles of visits, recorded by "
+    "programs built with VARI_PROFILE_VISITS")
+parser.add_argument("profiles", nargs="+", help="profiles written by the instrumented programs")
+parser.add_argument("-o", "--output", help="header to write, standard output by default")
+parser.add_argument(
+    "--include", action="append", default=[],
+    help="header declaring the profiled types, included by the generated header")
+parser.add_argument(
+    "--all", action="store_true",
+    help="emit also the sets which are already ordered by frequency")
+args = parser.parse_args()
+
+
+def parse(fd, sets):
+    """Adds histograms from profile `fd` into `sets`, a dict of tuple of types -> counts."""
+    lines = iter(fd.read().splitlines())
+    for line in lines:
+        kw, n = line.split()
+        if kw != "set":
+            raise ValueError(f"expected set line, got: {line}")
+        types = []
+        counts = []
+        for _ in range(int(n)):
+            count, name = next(lines).split(" ", 1)
+            types.append(name)
+            counts.append(int(count))
+        kw, null = next(lines).split()
+        if kw != "null":
+            raise ValueError(f"expected null line, got: {kw}")
+        key = tuple(types)
+        prev = sets.get(key, [0] * len(types))
+        sets[key] = [a + b for a, b in zip(prev, counts)]
+
+
+def typelist(types):
+    return f"typelist< {', '.join(types)} >"
+
+
+# Names of types that can't be spelled outside of their scope: anonymous namespaces, local types
+# (`f()::X`) and closures
+UNSPELLABLE = ("(anonymous namespace)", "`anonymous namespace'", "{anonymous}", ")::", "<lambda",
+               "{lambda", "<unnamed", "{unnamed")
+
+
+def spellable(types):
+    return not any(u in t for t in types for u in UNSPELLABLE)
+
+
+def gen_order(fd, types, counts, origins):
+    # sort is stable, types with equal counts keep the original order
+    hot = sorted(range(len(types)), key=lambda i: -counts[i])
+    if hot == list(range(len(types))) and not args.all:
+        return
+    ordered = tuple(types[i] for i in hot)
+    hist = ", ".join(f"{types[i]}: {counts[i]}" for i in hot)
+    fd.write(f"// {hist}\n")
+    fd.write("template <>\n")
+    fd.write(f"struct typelist_order< {typelist(types)} >\n")
+    fd.write("{\n")
+    fd.write(f"        using type = {typelist(ordered)};\n")
+    fd.write("};\n\n")
+    # Later profiles record the reordered set under the original one
+    if ordered in origins:
+        print(f"warning: {typelist(types)} gets the same order as {typelist(origins[ordered])}, "
+              "later profiles record both under the latter", file=sys.stderr)
+        return
+    origins[ordered] = types
+    fd.write("template <>\n")
+    fd.write(f"struct typelist_origin< {typelist(ordered)} >\n")
+    fd.write("{\n")
+    fd.write(f"        using type = {typelist(types)};\n")
+    fd.write("};\n\n")
+
+
+sets = {}
+for p in args.profiles:
+    with open(p) as fd:
+        parse(fd, sets)
+
+out = open(args.output, "w") if args.output else sys.stdout
+out.write(f"// Generated by profile_order.py from: {' '.join(args.profiles)}\n\n")
+out.write("#pragma once\n\n")
+for inc in args.include:
+    out.write(f"#include \"{inc}\"\n")
+out.write("#include <vari/bits/typelist.h>\n\n")
+# Type names are spelled relative to the vari namespace by some compilers
+out.write("namespace vari\n{\n\n")
+origins = {}
+for types, counts in sorted(sets.items()):
+    if sum(counts) == 0 or len(types) < 2:
+        continue
+    if not spellable(types):
+        print(f"warning: skipping {typelist(types)}, its types can't be named in a header",
+              file=sys.stderr)
+        continue
+    gen_order(out, types, counts, origins)
+out.write("}  // namespace vari\n")
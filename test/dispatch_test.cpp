@@ -82,4 +82,67 @@ TEST_CASE( "dispatch multiple fun" )
         }
 }
 
+template < dispatch_strategy S, index_type N >
+constexpr bool dispatch_all()
+{
+        for ( index_type i = 0; i < N; i++ ) {
+                index_type k = _dispatch_index< 0, N, S >( i, [&]< index_type j >() {
+                        return j;
+                } );
+                if ( k != i )
+                        return false;
+        }
+        return true;
+}
+
+template < dispatch_strategy S >
+constexpr bool dispatch_sizes()
+{
+        return dispatch_all< S, 1 >() && dispatch_all< S, 2 >() && dispatch_all< S, 3 >() &&
+               dispatch_all< S, 7 >() && dispatch_all< S, 32 >() && dispatch_all< S, 33 >() &&
+               dispatch_all< S, 100 >() && dispatch_all< S, 300 >();
+}
+
+static_assert( dispatch_sizes< dispatch_strategy::automatic >() );
+static_assert( dispatch_sizes< dispatch_strategy::jump_table >() );
+static_assert( dispatch_sizes< dispatch_strategy::fun_table >() );
+static_assert( dispatch_sizes< dispatch_strategy::binary >() );
+static_assert( dispatch_sizes< dispatch_strategy::if_chain >() );
+
+static_assert( _select_dispatch_strategy( 2 ) == dispatch_strategy::if_chain );
+static_assert( _select_dispatch_strategy( 16 ) == dispatch_strategy::jump_table );
+static_assert( _select_dispatch_strategy( 200 ) == dispatch_strategy::jump_table );
+static_assert( _select_dispatch_strategy( 300 ) == dispatch_strategy::fun_table );
+
+TEST_CASE( "dispatch strategy" )
+{
+        CHECK( dispatch_sizes< dispatch_strategy::automatic >() );
+        CHECK( dispatch_sizes< dispatch_strategy::jump_table >() );
+        CHECK( dispatch_sizes< dispatch_strategy::fun_table >() );
+        CHECK( dispatch_sizes< dispatch_strategy::binary >() );
+        CHECK( dispatch_sizes< dispatch_strategy::if_chain >() );
+
+        static constexpr std::size_t N = 42;
+
+        for ( std::size_t i = 0; i < N; i++ ) {
+                std::size_t k = dispatch< N, dispatch_strategy::binary >(
+                    i,
+                    [&]< std::size_t j >() {
+                            return test_tag< j >{};
+                    },
+                    [&]( auto tag ) {
+                            return tag.value;
+                    } );
+                CHECK_EQ( k, i );
+        }
+
+        // references are passed through function tables as they are
+        int  x = 0;
+        int& r = _dispatch_index< 0, 5, dispatch_strategy::fun_table >(
+            3, [&]< index_type >() -> int& {
+                    return x;
+            } );
+        CHECK_EQ( &r, &x );
+}
+
 }  // namespace vari
@@ -38,6 +38,8 @@ def gen_cpp(lines):
     #include <vari/vref.h>
     #include <vari/vcast.h>
     #include <vari/dispatch.h>
+    #include <vari/visit.h>
+    #include <vari/visitor.h>
 
     #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 
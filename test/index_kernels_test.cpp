@@ -0,0 +1,180 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "vari/index_kernels.h"
+#include "vari/vptr.h"
+#include "vari/vval.h"
+
+#include <doctest/doctest.h>
+#include <vector>
+
+namespace vari
+{
+
+namespace
+{
+
+template < std::size_t I >
+struct ktag
+{
+};
+
+using small_tl = typelist< ktag< 0 >, ktag< 1 >, ktag< 2 >, ktag< 3 >, ktag< 4 > >;
+
+template < typename Seq >
+struct ktags;
+
+template < std::size_t... Is >
+struct ktags< std::index_sequence< Is... > >
+{
+        using type = typelist< ktag< Is >... >;
+};
+
+using big_tl = typename ktags< std::make_index_sequence< 20 > >::type;
+
+template < typename E, std::size_t N >
+std::vector< E > random_indexes( std::size_t n )
+{
+        std::vector< E > res;
+        std::uint32_t    seed = 7;
+        for ( std::size_t i = 0; i < n; i++ ) {
+                seed = seed * 1664525u + 1013904223u;
+                // Roughly one in N + 1 is null
+                std::size_t const x = ( seed >> 16 ) % ( N + 1 );
+                res.push_back( x == N ? static_cast< E >( null_index ) : static_cast< E >( x ) );
+        }
+        return res;
+}
+
+template < typename E, std::size_t K >
+void check_kernel( _match_blocks_fn< E, K > kernel, std::array< E, K > const& set )
+{
+        auto const                   ixs = random_indexes< E, 5 >( 64 * 5 );
+        std::vector< std::uint64_t > got( 5 ), expected( 5 );
+        kernel( ixs.data(), 5, set, got.data() );
+        _match_blocks_scalar< E, K >( ixs.data(), 5, set, expected.data() );
+        CHECK_EQ( got, expected );
+}
+
+template < typename E >
+void check_kernels()
+{
+        std::array< E, 2 > const set{ 1, 3 };
+        check_kernel< E, 2 >( _match_blocks_kernel< E, 2 >(), set );
+#if VARI_SIMD_X86
+        check_kernel< E, 2 >( &_match_blocks_sse2< E, 2 >, set );
+        if ( _cpu_has_avx2() )
+                check_kernel< E, 2 >( &_match_blocks_avx2< E, 2 >, set );
+#endif
+}
+
+template < typename TL, typename E >
+void check_ops( std::size_t n )
+{
+        auto const           ixs = random_indexes< E, TL::size >( n );
+        std::span< E const > s{ ixs };
+
+        std::array< std::size_t, TL::size + 1 > hist{};
+        std::vector< std::size_t >              pos;
+        for ( std::size_t i = 0; i < n; i++ ) {
+                hist[std::min< std::size_t >( ixs[i], TL::size )] += 1;
+                if ( ixs[i] == 1 || ixs[i] == 3 )
+                        pos.push_back( i );
+        }
+        CHECK_EQ( index_histogram< TL >( s ), hist );
+        CHECK_EQ( ( match_count< TL, ktag< 1 >, ktag< 3 > >( s ) ), pos.size() );
+
+        std::vector< std::size_t > got;
+        match_positions< TL, ktag< 3 >, ktag< 1 > >( s, std::back_inserter( got ) );
+        CHECK_EQ( got, pos );
+
+        std::vector< std::uint64_t > words( ( n + 63 ) / 64 );
+        match_mask< TL, typelist< ktag< 1 >, ktag< 3 > > >( s, words );
+        for ( std::size_t i = 0; i < n; i++ )
+                CHECK_EQ(
+                    ( words[i / 64] >> ( i % 64 ) ) & 1, ( ixs[i] == 1 || ixs[i] == 3 ) ? 1 : 0 );
+
+        for ( std::size_t from : { std::size_t{ 0 }, std::size_t{ 5 }, std::size_t{ 70 }, n } ) {
+                auto it = std::lower_bound( pos.begin(), pos.end(), from );
+                CHECK_EQ(
+                    ( match_find_first< TL, ktag< 1 >, ktag< 3 > >( s, from ) ),
+                    it == pos.end() ? n : *it );
+        }
+}
+
+}  // namespace
+
+TEST_CASE( "index kernels" )
+{
+        check_kernels< std::uint8_t >();
+        check_kernels< std::uint16_t >();
+        check_kernels< std::uint32_t >();
+
+        for ( std::size_t n : { 0, 1, 63, 64, 65, 200, 64 * 40 + 3 } ) {
+                check_ops< small_tl, std::uint8_t >( n );
+                check_ops< small_tl, std::uint16_t >( n );
+                check_ops< small_tl, index_type >( n );
+                check_ops< big_tl, std::uint8_t >( n );
+                check_ops< big_tl, std::uint16_t >( n );
+        }
+}
+
+TEST_CASE( "index kernels empty set" )
+{
+        for ( std::size_t n : { 0, 1, 64, 200 } ) {
+                auto const                      ixs = random_indexes< std::uint8_t, 5 >( n );
+                std::span< std::uint8_t const > s{ ixs };
+
+                CHECK_EQ( ( match_count< small_tl >( s ) ), 0 );
+                std::vector< std::size_t > got;
+                match_positions< small_tl, typelist<> >( s, std::back_inserter( got ) );
+                CHECK( got.empty() );
+                std::vector< std::uint64_t > words( ( n + 63 ) / 64, ~std::uint64_t{ 0 } );
+                match_mask< small_tl >( s, words );
+                for ( std::uint64_t w : words )
+                        CHECK_EQ( w, 0 );
+                CHECK_EQ( ( match_find_first< small_tl >( s, 0 ) ), n );
+        }
+}
+
+TEST_CASE( "extract indexes" )
+{
+        int   i = 1;
+        float f = 2.f;
+
+        std::vector< vptr< int, float > > ptrs{ &i, nullptr, &f, &i };
+        std::vector< std::uint8_t >       ixs;
+        extract_indexes( ptrs, std::back_inserter( ixs ) );
+        CHECK_EQ( ixs, std::vector< std::uint8_t >{ 0, 255, 1, 0 } );
+        CHECK_EQ(
+            index_histogram< typelist< int, float > >( std::span< std::uint8_t const >{ ixs } ),
+            std::array< std::size_t, 3 >{ 2, 1, 1 } );
+
+        std::vector< vval< int, float > > vals{ 1, 2.f, 3.f };
+        ixs.clear();
+        extract_indexes( vals, std::back_inserter( ixs ) );
+        CHECK_EQ(
+            ( match_count< typelist< int, float >, float >(
+                std::span< std::uint8_t const >{ ixs } ) ),
+            2 );
+}
+
+}  // namespace vari
@@ -0,0 +1,85 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "vari/intern_pool.h"
+
+#include <doctest/doctest.h>
+#include <string>
+#include <vector>
+
+namespace vari
+{
+
+static_assert( std::same_as<
+               intern_pool< typelist< int >, std::string >,
+               _intern_pool< int, std::string > > );
+
+TEST_CASE( "intern_pool" )
+{
+        intern_pool< int, std::string > p;
+        CHECK( p.empty() );
+
+        auto a = p.intern( 1 );
+        auto b = p.intern( std::string{ "foo" } );
+        auto c = p.intern( 1 );
+        auto d = p.intern( std::string{ "foo" } );
+        CHECK_EQ( p.size(), 2 );
+        CHECK_EQ( a, c );
+        CHECK_EQ( b, d );
+        CHECK_NE( a, b );
+        CHECK( p.contains( 1 ) );
+        CHECK_FALSE( p.contains( 2 ) );
+        CHECK( p.contains( std::string{ "foo" } ) );
+
+        a.visit(
+            [&]( int const& x ) {
+                    CHECK_EQ( x, 1 );
+            },
+            [&]( std::string const& ) {
+                    FAIL( "" );
+            } );
+
+        vval< int, std::string > v{ std::string{ "foo" } };
+        CHECK_EQ( p.intern( v ), b );
+        vval< int > w{ 1 };
+        CHECK_EQ( p.intern( w ), a );
+        CHECK_EQ( p.size(), 2 );
+
+        p.clear();
+        CHECK( p.empty() );
+}
+
+TEST_CASE( "intern_pool_stable" )
+{
+        intern_pool< int, std::string > p;
+        std::vector< _vref< int const, std::string const > > refs;
+        for ( int i = 0; i < 1000; ++i )
+                refs.push_back( p.intern( i ) );
+        for ( int i = 0; i < 1000; ++i )
+                refs.push_back( p.intern( std::to_string( i ) ) );
+        CHECK_EQ( p.size(), 2000 );
+        for ( int i = 0; i < 1000; ++i ) {
+                CHECK_EQ( refs[i], p.intern( i ) );
+                CHECK_EQ( refs[1000 + i], p.intern( std::to_string( i ) ) );
+        }
+}
+
+}  // namespace vari
@@ -22,6 +22,8 @@
 /// SOFTWARE.
 #include "vari/bits/typelist.h"
 
+#include "vari/bits/profile.h"
+
 #include "test_types.h"
 #include "vari/concept.h"
 #include "vari/uvptr.h"
@@ -302,4 +304,55 @@ static_assert( variadic_with< uvptr< int, float >, typelist<> > );
 static_assert( variadic_with_type< vref< int, float >, int > );
 static_assert( variadic_with_type< uvptr< int, float >, int > );
 
+/// ---
+
+struct ord_a
+{
+};
+struct ord_b
+{
+};
+struct ord_c
+{
+};
+
+template <>
+struct typelist_order< typelist< ord_a, ord_b, ord_c > >
+{
+        using type = typelist< ord_c, ord_a, ord_b >;
+};
+
+static_assert( std::same_as< vref< ord_a, ord_b, ord_c >, _vref< ord_c, ord_a, ord_b > > );
+static_assert(
+    std::same_as< vref< typelist< ord_a, ord_b >, ord_c >, _vref< ord_c, ord_a, ord_b > > );
+static_assert( std::same_as< vref< ord_a, ord_b >, _vref< ord_a, ord_b > > );
+static_assert( std::same_as< vref< ord_b, ord_a, ord_c >, _vref< ord_b, ord_a, ord_c > > );
+static_assert( std::is_constructible_v< vref< ord_a, ord_b, ord_c >, vref< ord_b, ord_a > > );
+static_assert( std::same_as<
+               typelist_origin< typelist< ord_c, ord_a, ord_b > >::type,
+               _canonical_typelist_t< typelist< ord_c, ord_a, ord_b > > > );
+
+static_assert( _type_name< int >() == "int" );
+static_assert( _type_name< ord_a >().ends_with( "ord_a" ) );
+
+static_assert( std::same_as<
+               _canonical_typelist< typelist< ord_c, ord_a, ord_b > >::type,
+               typelist< ord_a, ord_b, ord_c > > );
+static_assert( std::same_as<
+               _canonical_typelist< typelist< ord_b, ord_a > >::type,
+               _canonical_typelist< typelist< ord_a, ord_b > >::type > );
+static_assert( std::same_as< _canonical_typelist< typelist<> >::type, typelist<> > );
+
+static_assert( _vptr_cnv_map< typelist< int, float >, typelist< int > >::identity );
+static_assert( _vptr_cnv_map< typelist< int, float >, typelist< int, float > >::identity );
+static_assert( _vptr_cnv_map< typelist< int const, float >, typelist< int > >::identity );
+static_assert( !_vptr_cnv_map< typelist< int, float >, typelist< float > >::identity );
+static_assert( !_vptr_cnv_map< typelist< int, float >, typelist< float, int > >::identity );
+static_assert( _vptr_cnv_map< typelist< int, float >, typelist< int > >::conv( 0 ) == 0 );
+static_assert( _vptr_cnv_map< typelist< int, float >, typelist< int > >::conv( null_index ) ==
+               null_index );
+static_assert( _vptr_cnv_map< typelist< int, float >, typelist< float > >::conv( 0 ) == 1 );
+static_assert( _vptr_cnv_map< typelist< int, float >, typelist< float > >::conv( null_index ) ==
+               null_index );
+
 }  // namespace vari
@@ -0,0 +1,556 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "vari/partition.h"
+#include "vari/visit.h"
+#include "vari/visitor.h"
+
+#include <doctest/doctest.h>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace vari
+{
+
+TEST_CASE( "visit pair" )
+{
+        int         i = 1;
+        float       f = 2.f;
+        std::string s = "three";
+
+        vval< int, std::string > v{ 4 };
+        vptr< float, std::string > p{ &f };
+
+        auto fn = [&]( auto& v, auto& p ) {
+                return visit(
+                    v,
+                    p,
+                    [&]( int& x, float& y ) {
+                            return x + static_cast< int >( y );
+                    },
+                    [&]( int&, std::string& ) {
+                            return 10;
+                    },
+                    [&]( std::string&, auto& ) {
+                            return 20;
+                    },
+                    [&]( auto&, empty_t ) {
+                            return 30;
+                    } );
+        };
+        CHECK_EQ( fn( v, p ), 6 );
+        p = &s;
+        CHECK_EQ( fn( v, p ), 10 );
+        v = std::string{ "five" };
+        CHECK_EQ( fn( v, p ), 20 );
+        p = nullptr;
+        CHECK_EQ( fn( v, p ), 30 );
+
+        vref< int, float > r{ i };
+        vref< std::string > q{ s };
+        std::string const& res = visit(
+            r, q, [&]( auto&, std::string& x ) -> std::string const& {
+                    return x;
+            } );
+        CHECK_EQ( &res, &s );
+}
+
+template < typename T >
+concept arithmetic = std::is_arithmetic_v< T >;
+
+TEST_CASE( "visit pair null" )
+{
+        vopt< int, float > a;
+        vopt< int, float > b{ 2.f };
+
+        auto fn = [&]( auto const& a, auto const& b ) {
+                return visit(
+                    a,
+                    b,
+                    [&]( empty_t, empty_t ) {
+                            return 0;
+                    },
+                    [&]( empty_t, arithmetic auto const& ) {
+                            return 1;
+                    },
+                    [&]( arithmetic auto const&, empty_t ) {
+                            return 2;
+                    },
+                    [&]( arithmetic auto const& x, arithmetic auto const& y ) {
+                            return static_cast< int >( x + y );
+                    } );
+        };
+        CHECK_EQ( fn( a, b ), 1 );
+        CHECK_EQ( fn( b, a ), 2 );
+        CHECK_EQ( fn( a, a ), 0 );
+        a = 3;
+        CHECK_EQ( fn( a, b ), 5 );
+}
+
+TEST_CASE( "visit pair mutate" )
+{
+        vval< int, float > a{ 1 };
+        uvptr< int, float > b{ uwrap( 2.f ) };
+
+        visit(
+            a,
+            b,
+            [&]( auto& x, auto& y ) {
+                    x += 1;
+                    y += 1;
+            },
+            [&]( auto&, empty_t ) {} );
+        CHECK_EQ( a.visit( [&]( auto& x ) -> float {
+                return x;
+        } ), 2.f );
+        CHECK_EQ(
+            b.visit(
+                [&]( empty_t ) {
+                        return 0.f;
+                },
+                [&]( auto& y ) -> float {
+                        return y;
+                } ),
+            3.f );
+}
+
+template < dispatch_strategy S >
+constexpr int constexpr_pair()
+{
+        vval< int, float, char > a{ 'c' };
+        vval< int, float > b{ 1.f };
+        int r = 0;
+        visit< S >( a, b, [&]( auto const& x, auto const& y ) {
+                r = static_cast< int >( x ) + static_cast< int >( y );
+        } );
+        return r;
+}
+
+static_assert( constexpr_pair< dispatch_strategy::automatic >() == 'c' + 1 );
+static_assert( constexpr_pair< dispatch_strategy::jump_table >() == 'c' + 1 );
+static_assert( constexpr_pair< dispatch_strategy::binary >() == 'c' + 1 );
+static_assert( constexpr_pair< dispatch_strategy::if_chain >() == 'c' + 1 );
+
+TEST_CASE( "visit_range" )
+{
+        std::vector< vval< int, std::string > > vals{
+            1, 2, std::string{ "a" }, 3, std::string{ "bc" }, std::string{ "d" }, 4 };
+
+        std::string order;
+        int         sum = 0;
+        visit_range(
+            vals,
+            [&]( int& x ) {
+                    order += 'i';
+                    sum += x;
+                    x = 0;
+            },
+            [&]( std::string& x ) {
+                    order += 's';
+                    sum += static_cast< int >( x.size() );
+            } );
+        CHECK_EQ( order, "iisissi" );
+        CHECK_EQ( sum, 14 );
+
+        auto const& cvals = vals;
+        sum               = 0;
+        visit_range( cvals, [&]( auto const& x ) {
+                if constexpr ( std::same_as< decltype( x ), int const& > )
+                        sum += x;
+                else
+                        sum += 1;
+        } );
+        CHECK_EQ( sum, 3 );
+
+        int                               i = 1;
+        float                             f = 2.f;
+        std::vector< vptr< int, float > > ptrs{ &i, &i, nullptr, &f, nullptr, nullptr, &i };
+        std::vector< int >                seen;
+        visit_range(
+            ptrs,
+            [&]( int& ) {
+                    seen.push_back( 0 );
+            },
+            [&]( float& ) {
+                    seen.push_back( 1 );
+            },
+            [&]( empty_t ) {
+                    seen.push_back( 2 );
+            } );
+        CHECK_EQ( seen, std::vector< int >{ 0, 0, 2, 1, 2, 2, 0 } );
+
+        std::vector< vptr< int, float > > empty_ptrs;
+        visit_range( empty_ptrs, [&]( auto& ) {}, [&]( empty_t ) {} );
+}
+
+struct big_item
+{
+        int v;
+        char pad[200];
+};
+
+template <>
+struct prefetch_traits< big_item >
+{
+        static constexpr std::size_t lines = 4;
+};
+
+template < typename R >
+concept prefetch_visitable = requires( R& r ) {
+        visit_range_prefetch( r, []< typename T >( T const& ) {} );
+};
+
+TEST_CASE( "visit_range_prefetch" )
+{
+        static_assert( prefetch_visitable< std::vector< vref< int > > > );
+        static_assert( !prefetch_visitable< std::vector< vval< int > > > );
+
+        std::vector< int >                    is{ 1, 2, 3 };
+        big_item                              b{ .v = 10, .pad = {} };
+        std::vector< uvptr< int, big_item > > owned;
+        owned.emplace_back( uwrap( big_item{ .v = 20, .pad = {} } ) );
+        owned.emplace_back( uwrap( 4 ) );
+
+        std::vector< vptr< int, big_item > > ptrs{ &is[0], &b, nullptr, &is[1], &is[2] };
+        for ( std::size_t i = 0; i < 40; i++ )
+                ptrs.push_back( i % 3 == 0 ? vptr< int, big_item >{ &b } : ptrs[i % 5] );
+
+        auto sum_of = [&]< std::size_t D >( auto& range ) {
+                int sum = 0;
+                visit_range_prefetch< D >(
+                    range,
+                    [&]( int& x ) {
+                            sum += x;
+                    },
+                    [&]( big_item& x ) {
+                            sum += x.v;
+                    },
+                    [&]( empty_t ) {
+                            sum += 100;
+                    } );
+                return sum;
+        };
+
+        int expected = 0;
+        for ( auto p : ptrs )
+                expected += p.visit(
+                    [&]( int& x ) {
+                            return x;
+                    },
+                    [&]( big_item& x ) {
+                            return x.v;
+                    },
+                    [&]( empty_t ) {
+                            return 100;
+                    } );
+        CHECK_EQ( sum_of.template operator()< 0 >( ptrs ), expected );
+        CHECK_EQ( sum_of.template operator()< 1 >( ptrs ), expected );
+        CHECK_EQ( sum_of.template operator()< 8 >( ptrs ), expected );
+        CHECK_EQ( sum_of.template operator()< 1000 >( ptrs ), expected );
+        CHECK_EQ( sum_of.template operator()< 4 >( owned ), 24 );
+}
+
+constexpr int constexpr_range()
+{
+        std::array< vopt< int, float >, 5 > arr{ 1, 2, 3.f, {}, 4 };
+        int                                 sum = 0;
+        visit_range(
+            arr,
+            [&]( empty_t ) {
+                    sum += 100;
+            },
+            [&]( arithmetic auto& x ) {
+                    sum += static_cast< int >( x );
+            } );
+        return sum;
+}
+
+static_assert( constexpr_range() == 110 );
+
+TEST_CASE( "visit_likely" )
+{
+        int         i = 1;
+        std::string s = "two";
+
+        auto fn = [&]< typename T >( auto&& v ) {
+                return visit_likely< T >(
+                    v,
+                    [&]( int& x ) {
+                            return x;
+                    },
+                    [&]( std::string& x ) {
+                            return static_cast< int >( x.size() );
+                    },
+                    [&]( empty_t ) {
+                            return -1;
+                    } );
+        };
+
+        vptr< int, std::string > p{ &i };
+        CHECK_EQ( fn.template operator()< int >( p ), 1 );
+        CHECK_EQ( fn.template operator()< std::string >( p ), 1 );
+        CHECK_EQ( fn.template operator()< empty_t >( p ), 1 );
+        p = &s;
+        CHECK_EQ( fn.template operator()< int >( p ), 3 );
+        CHECK_EQ( fn.template operator()< std::string >( p ), 3 );
+        p = nullptr;
+        CHECK_EQ( fn.template operator()< int >( p ), -1 );
+        CHECK_EQ( fn.template operator()< empty_t >( p ), -1 );
+
+        vval< int, std::string > const v{ std::string{ "four" } };
+        std::string const&             res = visit_likely< std::string >(
+            v,
+            [&]( int const& ) -> std::string const& {
+                    return s;
+            },
+            [&]( std::string const& x ) -> std::string const& {
+                    return x;
+            } );
+        CHECK_EQ( res, "four" );
+
+        vopt< int, float > o;
+        visit_likely< float >(
+            o,
+            [&]( arithmetic auto& x ) {
+                    x += 1;
+            },
+            [&]( empty_t ) {
+                    o = 5;
+            } );
+        CHECK_EQ(
+            o.visit(
+                [&]( int& x ) {
+                        return x;
+                },
+                [&]( float& ) {
+                        return 0;
+                },
+                [&]( empty_t ) {
+                        return 0;
+                } ),
+            5 );
+}
+
+TEST_CASE( "cold" )
+{
+        int                calls = 0;
+        vptr< int, float > p;
+        auto               fn = [&] {
+                return visit_likely< int >(
+                    p,
+                    [&]( int& x ) {
+                            return x;
+                    },
+                    cold( [&]( float& x ) mutable {
+                            calls++;
+                            return static_cast< int >( x );
+                    } ),
+                    cold( [&]( empty_t ) {
+                            calls++;
+                            return 0;
+                    } ) );
+        };
+
+        int   i = 1;
+        float f = 2.f;
+        CHECK_EQ( fn(), 0 );
+        p = &i;
+        CHECK_EQ( fn(), 1 );
+        p = &f;
+        CHECK_EQ( fn(), 2 );
+        CHECK_EQ( calls, 2 );
+
+        auto const c = cold( []( int x ) {
+                return x * 2;
+        } );
+        CHECK_EQ( vval< int >{ 3 }.visit( c ), 6 );
+}
+
+TEST_CASE( "partition_by_index" )
+{
+        int   is[4] = { 0, 1, 2, 3 };
+        float fs[2] = { 0.f, 1.f };
+
+        std::vector< vptr< int, float > > ptrs{
+            &is[0], &fs[0], nullptr, &is[1], &fs[1], &is[2], nullptr, &is[3] };
+        auto b = partition_by_index( ptrs );
+        static_assert( decltype( b )::count == 3 );
+
+        CHECK_EQ( b.get< int >().size(), 4 );
+        CHECK_EQ( b.get< float >().size(), 2 );
+        CHECK_EQ( b.null_bucket().size(), 2 );
+        for ( std::size_t i = 0; i < 4; i++ )
+                CHECK_EQ( ptrs[i], vptr< int, float >{ &is[i] } );
+        CHECK_EQ( ptrs[4], vptr< int, float >{ &fs[0] } );
+        CHECK_EQ( ptrs[5], vptr< int, float >{ &fs[1] } );
+        CHECK_FALSE( ptrs[6] );
+
+        std::vector< int > seen;
+        visit_buckets(
+            b,
+            [&]( int& x ) {
+                    seen.push_back( x );
+            },
+            [&]( float& x ) {
+                    seen.push_back( 10 + static_cast< int >( x ) );
+            },
+            [&]( empty_t ) {
+                    seen.push_back( -1 );
+            } );
+        CHECK_EQ( seen, std::vector< int >{ 0, 1, 2, 3, 10, 11, -1, -1 } );
+
+        std::vector< vval< std::string, int > > vals{
+            3, std::string{ "a" }, 4, std::string{ "b" }, std::string{ "c" }, 5 };
+        auto vb = partition_by_index( std::span{ vals } );
+        CHECK_EQ( vb[0].size(), 3 );
+        CHECK_EQ( vb[1].size(), 3 );
+
+        std::string str;
+        int         sum = 0;
+        visit_buckets(
+            vb,
+            [&]( std::string& x ) {
+                    str += x;
+            },
+            [&]( int& x ) {
+                    sum = sum * 10 + x;
+            } );
+        CHECK_EQ( str, "abc" );
+        CHECK_EQ( sum, 345 );
+
+        std::vector< vval< std::string, int > > none;
+        auto                                    nb = partition_by_index( none );
+        CHECK( nb[0].empty() );
+        CHECK( nb[1].empty() );
+}
+
+TEST_CASE( "visitor" )
+{
+        int         i = 1;
+        float       f = 2.f;
+        std::string s = "three";
+
+        auto vis = make_visitor< typelist< int, float, std::string > >(
+            [k = 10]( int& x ) {
+                    return x + k;
+            },
+            [k = 20]( float& x ) {
+                    return static_cast< int >( x ) + k;
+            },
+            []( std::string& x ) {
+                    return static_cast< int >( x.size() );
+            },
+            []( empty_t ) {
+                    return -1;
+            } );
+        static_assert( decltype( vis )::handles_null );
+
+        vptr< int, float, std::string > p{ &i };
+        CHECK_EQ( vis( p ), 11 );
+        p = &f;
+        CHECK_EQ( vis( p ), 22 );
+        p = nullptr;
+        CHECK_EQ( vis( p ), -1 );
+
+        // Subsets are converted to the index of the visitor
+        vref< std::string, float > r{ s };
+        CHECK_EQ( vis( r ), 5 );
+        vptr< float > q{ &f };
+        CHECK_EQ( vis( q ), 22 );
+
+        vval< float, int > v{ 3 };
+        CHECK_EQ( vis( v ), 13 );
+        vopt< std::string > o;
+        CHECK_EQ( vis( o ), -1 );
+        o = std::string{ "four" };
+        CHECK_EQ( vis( o ), 4 );
+
+        uvptr< int > u{ uwrap( 5 ) };
+        CHECK_EQ( vis( u ), 15 );
+
+        // Const items of values require const types
+        static_assert( !std::invocable< decltype( vis ) const&, vval< int > const& > );
+        auto cvis =
+            make_visitor< typelist< int const, float const > >( []( arithmetic auto const& x ) {
+                    return static_cast< int >( x );
+            } );
+        static_assert( !decltype( cvis )::handles_null );
+        vval< int, float > const cv{ 7.f };
+        CHECK_EQ( cvis( cv ), 7 );
+        vref< int const > cr{ i };
+        CHECK_EQ( cvis( cr ), 1 );
+        vref< float > mr{ f };
+        CHECK_EQ( cvis( mr ), 2 );
+}
+
+TEST_CASE( "visitor copy" )
+{
+        auto vis = make_visitor< typelist< int, float > >( [k = 1]( arithmetic auto& x ) {
+                return static_cast< int >( x ) + k;
+        } );
+        int  i   = 2;
+        auto v2( vis );
+        auto v3 = std::move( v2 );
+        std::vector< decltype( vis ) > vs{ vis, v3 };
+        vref< int, float >             r{ i };
+        CHECK_EQ( vis( r ), 3 );
+        CHECK_EQ( v3( r ), 3 );
+        for ( auto const& v : vs )
+                CHECK_EQ( v( r ), 3 );
+}
+
+struct vis_a
+{
+        int v;
+};
+struct vis_b
+{
+        int v;
+};
+
+template <>
+struct typelist_order< typelist< vis_a, vis_b > >
+{
+        using type = typelist< vis_b, vis_a >;
+};
+
+TEST_CASE( "visitor ordered" )
+{
+        auto vis = make_visitor< typelist< vis_a, vis_b > >(
+            []( vis_a& x ) {
+                    return x.v;
+            },
+            []( vis_b& x ) {
+                    return -x.v;
+            } );
+        static_assert( std::same_as< decltype( vis )::types, vref< vis_a, vis_b >::types > );
+        static_assert( std::same_as< decltype( vis )::types, typelist< vis_b, vis_a > > );
+
+        vis_a                a{ 1 };
+        vis_b                b{ 2 };
+        vref< vis_a, vis_b > r{ a };
+        CHECK_EQ( vis( r ), 1 );
+        vref< vis_a, vis_b > r2{ b };
+        CHECK_EQ( vis( r2 ), -2 );
+}
+
+}  // namespace vari
@@ -46,6 +46,7 @@
 #include "vari/uvptr.h"
 #include "vari/uvref.h"
 #include "vari/vcast.h"
+#include "vari/vptr_array.h"
 #include "vari/vref.h"
 
 #include <doctest/doctest.h>
@@ -692,6 +693,136 @@ TEST_CASE_TEMPLATE(
         }
 }
 
+struct alignas( 8 ) tagged_a
+{
+        int v = 1;
+};
+
+struct alignas( 8 ) tagged_b
+{
+        int v = 2;
+};
+
+struct tagged_c
+{
+        char v = 3;
+};
+
+template <>
+struct ptr_tag_traits< typelist< tagged_a, tagged_b > >
+{
+        static constexpr ptr_tag_mode mode = ptr_tag_mode::low_bits;
+};
+
+template <>
+struct ptr_tag_traits< typelist< tagged_b, tagged_a, tagged_c > >
+{
+        static constexpr ptr_tag_mode mode = ptr_tag_mode::any;
+};
+
+template <>
+struct ptr_tag_traits< typelist< tagged_a, tagged_c > >
+{
+        static constexpr ptr_tag_mode mode = ptr_tag_mode::low_bits;
+};
+
+static_assert( std::same_as<
+               _ptr_core< typelist< tagged_a, tagged_b > >::storage_type,
+               _ptr_tagged_storage< 0, 1 > > );
+static_assert( sizeof( vptr< tagged_a, tagged_b > ) == sizeof( void* ) );
+static_assert( sizeof( vref< tagged_a, tagged_b > ) == sizeof( void* ) );
+static_assert( sizeof( uvptr< tagged_a, tagged_b > ) == sizeof( void* ) );
+static_assert( std::same_as<
+               _ptr_core< typelist< tagged_a, tagged_c > >::storage_type,
+               _ptr_plain_storage > );
+static_assert(
+    _ptr_free_high_bits == 0 || sizeof( vptr< tagged_b, tagged_a, tagged_c > ) == sizeof( void* ) );
+
+#if defined( __x86_64__ ) && !defined( VARI_PTR_HIGH_BITS )
+// 57-bit addresses of LA57 leave 7 bits, sets needing more fall back to the plain layout
+static_assert( _ptr_free_high_bits == 7 );
+#elif defined( __aarch64__ ) && !defined( VARI_PTR_HIGH_BITS )
+static_assert( _ptr_free_high_bits == 0 );
+#endif
+
+template < std::size_t N >
+struct tagged_n
+{
+};
+
+template < typename Is >
+struct tagged_n_set;
+
+template < std::size_t... Is >
+struct tagged_n_set< std::index_sequence< Is... > >
+{
+        using type = typelist< tagged_n< Is >... >;
+};
+
+template < std::size_t... Is >
+struct ptr_tag_traits< typelist< tagged_n< Is >... > >
+{
+        static constexpr ptr_tag_mode mode = ptr_tag_mode::high_bits;
+};
+
+static_assert( std::same_as<
+               _ptr_storage_t< tagged_n_set< std::make_index_sequence< 129 > >::type >,
+               _ptr_plain_storage > );
+static_assert(
+    _ptr_free_high_bits != 7 ||
+    std::same_as<
+        _ptr_storage_t< tagged_n_set< std::make_index_sequence< 128 > >::type >,
+        _ptr_tagged_storage< 57, ~std::uintptr_t{ 0 } << 57, true > > );
+
+TEST_CASE( "tagged ptr" )
+{
+        tagged_a a;
+        tagged_b b;
+        tagged_c c;
+
+        vptr< tagged_a, tagged_b > p1{ &b };
+        CHECK_EQ( p1.index(), 1 );
+        CHECK_EQ( p1.get(), &b );
+        p1.visit(
+            [&]( empty_t ) {
+                    FAIL( "incorrect overload" );
+            },
+            [&]( tagged_a& ) {
+                    FAIL( "incorrect overload" );
+            },
+            [&]( tagged_b& x ) {
+                    CHECK_EQ( &x, &b );
+            } );
+
+        vptr< tagged_b, tagged_a, tagged_c > p2 = p1;
+        CHECK_EQ( p2.index(), 0 );
+        CHECK_EQ( p2.get(), &b );
+        p2 = &c;
+        CHECK_EQ( p2.index(), 2 );
+        CHECK_EQ( p2.get(), &c );
+        p2 = vptr< tagged_a, tagged_b >{ &a };
+        CHECK_EQ( p2.index(), 1 );
+
+        vptr< tagged_a, tagged_c > p3{ vref< tagged_a >{ a } };
+        CHECK_EQ( p3.index(), 0 );
+        CHECK_EQ( p3.get(), &a );
+
+        vptr< tagged_a, tagged_b > p4;
+        CHECK( !p4 );
+        CHECK_EQ( p4.index(), null_index );
+        CHECK_EQ( p4.get(), nullptr );
+        swap( p1, p4 );
+        CHECK( !p1 );
+        CHECK_EQ( p4.index(), 1 );
+        check_hash( p4 );
+
+        uvptr< tagged_a, tagged_b > p5{ new tagged_a{} };
+        CHECK_EQ( p5.index(), 0 );
+        uvref< tagged_a, tagged_b > r1 = std::move( p5 ).vref();
+        CHECK_EQ( r1.index(), 0 );
+        CHECK_EQ( r1.vptr().index(), 0 );
+}
+
 struct vcast_base
 {
 };
@@ -726,4 +857,51 @@ TEST_CASE( "vcast" )
         }
 }
 
+TEST_CASE( "vptr_array" )
+{
+        static_assert( sizeof( vptr_array< int, float >::index_storage ) == 1 );
+
+        int         i1 = 1, i2 = 2;
+        float       f1 = 3.f;
+        std::string s1 = "s";
+
+        vptr_array< int, float, std::string > arr;
+        arr.push_back( i1 );
+        arr.push_back( s1 );
+        arr.push_back( vptr< int, float >{} );
+        arr.push_back( f1 );
+        arr.push_back( vptr< int >{ &i2 } );
+        arr.push_back( s1 );
+        CHECK_EQ( arr.size(), 6 );
+
+        CHECK_EQ( arr[0], vptr< int, float, std::string >{ &i1 } );
+        CHECK_FALSE( arr[2] );
+        CHECK_EQ( arr.index( 2 ), null_index );
+        CHECK_EQ( arr.index( 3 ), 1 );
+        CHECK_EQ( arr.indexes()[2], arr.null_value );
+        CHECK_EQ( arr.ref( 4 ).index(), 0 );
+
+        CHECK_EQ( arr.counts(), std::array< std::size_t, 4 >{ 2, 1, 2, 1 } );
+        CHECK_EQ( arr.count< int >(), 2 );
+        CHECK_EQ( ( arr.count< int, std::string >() ), 4 );
+        CHECK_EQ( arr.find_first< std::string >(), 1 );
+        CHECK_EQ( arr.find_first< std::string >( 2 ), 5 );
+        CHECK_EQ( arr.find_first< float >( 4 ), arr.size() );
+
+        std::vector< std::size_t > pos;
+        arr.filter< float, std::string >( std::back_inserter( pos ) );
+        CHECK_EQ( pos, std::vector< std::size_t >{ 1, 3, 5 } );
+
+        arr.set( 2, vptr< float >{ &f1 } );
+        CHECK_EQ( arr.count< float >(), 2 );
+        arr.pop_back();
+        CHECK_EQ( arr.size(), 5 );
+        arr.clear();
+        CHECK( arr.empty() );
+
+        vptr_array< int const > carr;
+        carr.push_back( i1 );
+        CHECK_EQ( *carr[0], 1 );
+}
+
 }  // namespace vari
@@ -0,0 +1,161 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "./common.h"
+#include "vari/visit.h"
+#include "vari/vseq.h"
+
+#include <doctest/doctest.h>
+#include <memory>
+#include <string>
+
+namespace vari
+{
+
+static_assert( std::forward_iterator< vseq< int, float >::iterator > );
+static_assert( std::forward_iterator< vseq< int, float >::const_iterator > );
+
+TEST_CASE( "vseq" )
+{
+        vseq< char, double, std::string > s;
+        CHECK( s.empty() );
+
+        s.push_back( 'a' );
+        s.push_back( 1.5 );
+        s.push_back( 'b' );
+        s.emplace< std::string >( 2, 'c' );
+        CHECK_EQ( s.size(), 4 );
+        // Records are packed: one byte header and a char take two bytes
+        CHECK_LT( s.bytes(), 4 * sizeof( vval< char, double, std::string > ) );
+
+        std::string order;
+        s.for_each(
+            [&]( char& c ) {
+                    order += c;
+                    c += 1;
+            },
+            [&]( double& ) {
+                    order += 'd';
+            },
+            [&]( std::string& x ) {
+                    order += x;
+            } );
+        CHECK_EQ( order, "adbcc" );
+
+        // Force growth with relocation of the strings
+        for ( int i = 0; i < 200; i++ )
+                s.push_back( std::string( 40, 'x' ) );
+        CHECK_EQ( s.size(), 204 );
+
+        order.clear();
+        std::size_t n = 0;
+        for ( vref< char, double, std::string > r : s ) {
+                if ( n++ == 4 )
+                        break;
+                r.visit(
+                    [&]( char& c ) {
+                            order += c;
+                    },
+                    [&]( double& d ) {
+                            CHECK_EQ( d, 1.5 );
+                            order += 'd';
+                    },
+                    [&]( std::string& x ) {
+                            order += x;
+                    } );
+        }
+        CHECK_EQ( order, "bdccc" );
+
+        vseq< char, double, std::string > const& cs  = s;
+        std::size_t                              len = 0;
+        visit_range(
+            cs,
+            [&]( std::string const& x ) {
+                    len += x.size();
+            },
+            [&]< one_of< typelist< char, double > > U >( U const& ) {} );
+        CHECK_EQ( len, 2 + 200 * 40 );
+
+        vseq< char, double, std::string > moved = std::move( s );
+        CHECK( s.empty() );
+        CHECK_EQ( moved.size(), 204 );
+        moved.clear();
+        CHECK( moved.empty() );
+        CHECK_EQ( moved.begin(), moved.end() );
+}
+
+TEST_CASE( "vseq destroy" )
+{
+        auto p = std::make_shared< int >( 1 );
+        {
+                vseq< std::shared_ptr< int >, int > s;
+                for ( int i = 0; i < 100; i++ ) {
+                        s.push_back( p );
+                        s.push_back( i );
+                }
+                CHECK_EQ( p.use_count(), 101 );
+        }
+        CHECK_EQ( p.use_count(), 1 );
+}
+
+TEST_CASE( "vseq self emplace" )
+{
+        // Arguments referring to objects of the sequence have to survive the growth of the buffer,
+        // for both the relocation one by one and the bytewise one
+        vseq< std::string, int > s;
+        std::size_t              grows = 0;
+        std::size_t              cap   = s.capacity_bytes();
+        auto                     count = [&] {
+                if ( s.capacity_bytes() != cap )
+                        grows++;
+                cap = s.capacity_bytes();
+        };
+
+        std::string* str = &s.emplace< std::string >( 100, 'a' );
+        for ( int k = 0; k < 100; k++ ) {
+                str = &s.emplace< std::string >( *str );
+                count();
+        }
+        CHECK_GT( grows, 0 );
+
+        vseq< int, char > t;
+        int*              i = &t.emplace< int >( 7 );
+        for ( int k = 0; k < 100; k++ )
+                i = &t.push_back( *i );
+        CHECK_GT( t.capacity_bytes(), 64 );
+
+        std::size_t n = 0;
+        s.for_each(
+            [&]( std::string& x ) {
+                    CHECK_EQ( x, std::string( 100, 'a' ) );
+                    n++;
+            },
+            [&]( int& ) {} );
+        t.for_each(
+            [&]( int& x ) {
+                    CHECK_EQ( x, 7 );
+                    n++;
+            },
+            [&]( char& ) {} );
+        CHECK_EQ( n, 202 );
+}
+
+}  // namespace vari
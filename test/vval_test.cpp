@@ -45,8 +45,11 @@
 #include "test_types.h"
 #include "vari/vopt.h"
 
+#include <array>
 #include <doctest/doctest.h>
+#include <memory>
 #include <source_location>
+#include <stdexcept>
 #include <vector>
 
 namespace vari
@@ -68,21 +71,119 @@ static_assert( valid_split<
                typelist< int, float >,
                typelist< char, uint8_t > > );
 
+static_assert( std::same_as< chunk_t< 2, typelist<> >, typelist<> > );
+static_assert( std::same_as< chunk_t< 2, typelist< int > >, typelist< typelist< int > > > );
+static_assert( std::same_as<
+               chunk_t< 2, typelist< int, float, char > >,
+               typelist< typelist< int, float >, typelist< char > > > );
+static_assert( std::same_as<
+               chunk_t< 2, typelist< int, float, char, bool > >,
+               typelist< typelist< int, float >, typelist< char, bool > > > );
+
+static_assert( _val_union< flatten_t< big_set > >::boxes_types::size == 7 );
+static_assert( std::same_as<
+               std::remove_cvref_t< decltype( _val_union< flatten_t< big_set > >::get< 200 >(
+                   std::declval< _val_union< flatten_t< big_set > >& >() ) ) >,
+               tag< 200 > > );
+
+static_assert( std::same_as< _index_storage_t< 1 >, uint8_t > );
+static_assert( std::same_as< _index_storage_t< 255 >, uint8_t > );
+static_assert( std::same_as< _index_storage_t< 256 >, uint16_t > );
+static_assert( std::same_as< _index_storage_t< 65535 >, uint16_t > );
+static_assert( std::same_as< _index_storage_t< 65536 >, index_type > );
+
+static_assert( sizeof( vval< int8_t, bool, char > ) == 2 );
+static_assert( sizeof( vopt< int8_t, bool, char > ) == 2 );
+static_assert( sizeof( vval< int16_t, char > ) == 4 );
+static_assert( sizeof( vval< uint64_t, char > ) == 16 );
+// Tail padding of an item is not reused for the tag
+struct padded_item
+{
+        int  a;
+        char b;
+};
+static_assert( sizeof( vval< padded_item, char > ) == sizeof( padded_item ) + alignof( int ) );
+static_assert( std::same_as< _val_core< flatten_t< big_set > >::tag_type, uint8_t > );
+
+template < typename Seq >
+struct trivial_set;
+
+template < std::size_t... Is >
+struct trivial_set< std::index_sequence< Is... > >
+{
+        using type = vval< std::integral_constant< std::size_t, Is >... >;
+};
+
+static_assert( std::is_trivially_copyable_v< vval< int, float > > );
+static_assert( std::is_trivially_copyable_v<
+               typename trivial_set< std::make_index_sequence< 40 > >::type > );
+static_assert( std::is_trivially_copyable_v< vopt< int, float > > );
+static_assert( !std::is_trivially_copyable_v< vval< big_set > > );
+static_assert( std::is_trivially_destructible_v< vopt< int, float > > );
+static_assert( !std::is_trivially_copyable_v< vval< int, std::string > > );
+static_assert( !std::is_trivially_destructible_v< vopt< int, std::string > > );
+static_assert( std::is_copy_constructible_v< vval< int, std::string > > );
+static_assert( !std::is_trivially_move_constructible_v< vval< int, std::unique_ptr< int > > > );
+
+constexpr std::array< vval< int, float >, 3 > constexpr_table{ 1, 2.f, 3 };
+static_assert( constexpr_table[0].index() == 0 );
+static_assert( constexpr_table[1].index() == 1 );
+static_assert( constexpr_table[0] == vval< int, float >{ 1 } );
+static_assert( constexpr_table[0] < constexpr_table[2] );
+static_assert( constexpr_table[2].visit( []( auto const& x ) {
+        return static_cast< int >( x );
+} ) == 3 );
+
+constinit vopt< int, float > constinit_opt{ 4.f };
+constexpr vopt< int, float > constexpr_null;
+static_assert( !constexpr_null );
+
+consteval std::size_t constexpr_ops()
+{
+        vval< int, float > a{ 1 };
+        vval< int, float, char > b{ a };
+        a = 2.f;
+        vopt< int, float > o{ a };
+        vval< int, float > c{ 3 };
+        swap( a, c );
+        c = a;
+        o = vopt< int, float >{};
+        return a.index() + 2 * b.index() + 4 * c.index() + ( o ? 8 : 0 );
+}
+static_assert( constexpr_ops() == 0 );
+
+consteval std::size_t constexpr_chunked()
+{
+        using V = typename trivial_set< std::make_index_sequence< 40 > >::type;
+        V a{ std::integral_constant< std::size_t, 3 >{} };
+        a = std::integral_constant< std::size_t, 37 >{};
+        V b{ a };
+        return b.index();
+}
+static_assert( constexpr_chunked() == 37 );
+
 TEST_CASE( "val_core" )
 {
         _val_core< typelist< float, char > > c1;
-        CHECK_EQ( c1.index, null_index );
+        CHECK_EQ( c1.get_index(), null_index );
 
         c1.emplace< float >( 0.1f );
-        CHECK_EQ( c1.index, 0 );
+        CHECK_EQ( c1.get_index(), 0 );
 
         c1.destroy();
-        CHECK_EQ( c1.index, null_index );
+        CHECK_EQ( c1.get_index(), null_index );
 
         c1.emplace< char >( 'w' );
-        CHECK_EQ( c1.index, 1 );
+        CHECK_EQ( c1.get_index(), 1 );
 
         c1.destroy();
+
+        _val_core< flatten_t< big_set > > c2;
+        CHECK_EQ( c2.get_index(), null_index );
+        c2.emplace< tag< 219 > >();
+        CHECK_EQ( c2.get_index(), 219 );
+        c2.destroy();
+        CHECK_EQ( c2.get_index(), null_index );
 }
 
 struct throw_mv_const : move_constructible< nothrow::NO >
@@ -194,6 +295,93 @@ void test_construct()
         vval_construct_test< T< int, throw_cp_const > >( throw_cp_const{}, nothrow::YES, 1 );
 }
 
+enum class niche_color : uint8_t
+{
+        red,
+        green,
+        blue
+};
+
+struct niche_handle
+{
+        int* p;
+
+        friend auto operator<=>( niche_handle const&, niche_handle const& ) = default;
+};
+
+struct niche_closed
+{
+        friend auto operator<=>( niche_closed const&, niche_closed const& ) = default;
+};
+
+struct niche_invalid
+{
+        friend auto operator<=>( niche_invalid const&, niche_invalid const& ) = default;
+};
+
+template <>
+struct niche_traits< niche_color > : niche_values< niche_color, uint8_t{ 255 }, uint8_t{ 254 } >
+{
+};
+
+template <>
+struct niche_traits< niche_handle > : niche_values< niche_handle, std::uintptr_t{ 0 } >
+{
+};
+
+static_assert( sizeof( vopt< niche_handle > ) == sizeof( niche_handle ) );
+static_assert( sizeof( vval< niche_handle, niche_closed > ) == sizeof( niche_handle ) + 8 );
+static_assert( sizeof( vopt< niche_color > ) == 1 );
+static_assert( sizeof( vval< niche_closed, niche_color > ) == 1 );
+static_assert( sizeof( vopt< niche_color, niche_closed, niche_invalid > ) == 2 );
+static_assert( sizeof( vopt< niche_color, int > ) == 8 );
+
+TEST_CASE( "niche" )
+{
+        int x = 42;
+
+        vopt< niche_handle > o1;
+        CHECK( !o1 );
+        CHECK_EQ( o1.index(), null_index );
+        o1 = niche_handle{ &x };
+        CHECK( o1 );
+        CHECK_EQ( o1.index(), 0 );
+        CHECK_EQ( o1->p, &x );
+
+        vopt< niche_handle > o2{ o1 };
+        CHECK_EQ( o1, o2 );
+        vopt< niche_handle > o3;
+        swap( o2, o3 );
+        CHECK( !o2 );
+        CHECK_EQ( o3->p, &x );
+
+        vval< niche_closed, niche_color > v1{ niche_color::green };
+        CHECK_EQ( v1.index(), 1 );
+        v1.visit(
+            [&]( niche_closed& ) {
+                    FAIL( "incorrect overload" );
+            },
+            [&]( niche_color& c ) {
+                    CHECK_EQ( c, niche_color::green );
+            } );
+        v1 = niche_closed{};
+        CHECK_EQ( v1.index(), 0 );
+        vval< niche_closed, niche_color > v2{ niche_color::red };
+        CHECK_NE( v1, v2 );
+        swap( v1, v2 );
+        CHECK_EQ( v1.index(), 1 );
+        CHECK_EQ( v2.index(), 0 );
+
+        vopt< niche_color, niche_closed, niche_invalid > o4{ niche_invalid{} };
+        CHECK_EQ( o4.index(), 2 );
+        o4 = niche_color::blue;
+        CHECK_EQ( o4.index(), 0 );
+        vopt< niche_color, niche_closed, niche_invalid > o5{ std::move( o4 ) };
+        CHECK_EQ( o5.index(), 0 );
+        o5.emplace< niche_closed >();
+        CHECK_EQ( o5.index(), 1 );
+}
+
 TEST_CASE( "vval_construct" )
 {
         test_construct< _vval >();
@@ -278,6 +466,259 @@ TEST_CASE( "vval_move" )
                 } );
 }
 
+struct lifetime_counter
+{
+        static inline int alive = 0;
+
+        lifetime_counter() noexcept
+        {
+                ++alive;
+        }
+        lifetime_counter( lifetime_counter const& ) noexcept
+        {
+                ++alive;
+        }
+        lifetime_counter& operator=( lifetime_counter const& ) noexcept = default;
+        ~lifetime_counter() noexcept
+        {
+                --alive;
+        }
+};
+
+TEST_CASE( "vval_lifetime" )
+{
+        {
+                vval< int, lifetime_counter > a{ lifetime_counter{} };
+                vval< int, lifetime_counter > b{ a };
+                CHECK_EQ( lifetime_counter::alive, 2 );
+                b = 42;
+                CHECK_EQ( lifetime_counter::alive, 1 );
+                b = a;
+                CHECK_EQ( lifetime_counter::alive, 2 );
+                a = b;
+                CHECK_EQ( lifetime_counter::alive, 2 );
+                a = vval< int, lifetime_counter >{ 42 };
+                CHECK_EQ( lifetime_counter::alive, 1 );
+
+                vopt< int, lifetime_counter > c{ b };
+                vopt< int, lifetime_counter > d;
+                CHECK_EQ( lifetime_counter::alive, 2 );
+                c = d;
+                CHECK_EQ( lifetime_counter::alive, 1 );
+                d = b;
+                CHECK_EQ( lifetime_counter::alive, 2 );
+        }
+        CHECK_EQ( lifetime_counter::alive, 0 );
+}
+
+struct throw_on_copy
+{
+        throw_on_copy() = default;
+        throw_on_copy( throw_on_copy const& )
+        {
+                throw std::runtime_error( "copy" );
+        }
+        throw_on_copy& operator=( throw_on_copy const& ) = default;
+};
+
+TEST_CASE( "vval_assign" )
+{
+        vval< int, std::vector< int > > v{ std::vector< int >( 64, 1 ) };
+        int const*                      data = v.visit(
+            []( int& ) -> int const* {
+                    return nullptr;
+            },
+            []( std::vector< int >& vec ) -> int const* {
+                    return vec.data();
+            } );
+
+        std::vector< int > const small{ 1, 2, 3 };
+        v = small;
+        v.visit(
+            []( int& ) {
+                    FAIL( "incorrect overload" );
+            },
+            [&]( std::vector< int >& vec ) {
+                    CHECK_EQ( vec.size(), 3 );
+                    CHECK_EQ( vec.data(), data );
+            } );
+
+        vval< int, std::vector< int > > other{ std::vector< int >{ 4 } };
+        v = other;
+        v.visit(
+            []( int& ) {
+                    FAIL( "incorrect overload" );
+            },
+            [&]( std::vector< int >& vec ) {
+                    CHECK_EQ( vec, std::vector< int >{ 4 } );
+                    CHECK_EQ( vec.data(), data );
+            } );
+
+        v = 42;
+        CHECK_EQ( v.index(), 0 );
+        v.assign_strong( std::vector< int >{ 5 } );
+        CHECK_EQ( v.index(), 1 );
+        v.assign_strong( other );
+        CHECK_EQ( v.index(), 1 );
+
+        vopt< int, std::vector< int > > o1{ 1 };
+        vopt< int, std::vector< int > > o2;
+        o1 = o2;
+        CHECK_FALSE( o1 );
+        o2.assign_strong( vopt< int, std::vector< int > >{ 2 } );
+        CHECK_EQ( o2.index(), 0 );
+
+        vval< int, throw_on_copy > t{ 42 };
+        throw_on_copy              toc;
+        CHECK_THROWS( t = toc );
+        CHECK_EQ( t.index(), 0 );
+        CHECK_THROWS( t.assign_strong( toc ) );
+        CHECK_EQ( t.index(), 0 );
+        static_assert( !noexcept( t = toc ) );
+        static_assert( noexcept( t = 42 ) );
+}
+
+struct reloc_handle
+{
+        std::unique_ptr< int > p;
+};
+
+template <>
+struct is_trivially_relocatable< reloc_handle > : std::true_type
+{
+};
+
+static_assert( is_trivially_relocatable_v< vval< int, float > > );
+static_assert( is_trivially_relocatable_v< vopt< int, reloc_handle > > );
+static_assert( !is_trivially_relocatable_v< vval< int, std::string > > );
+
+TEST_CASE( "relocate" )
+{
+        using V = vval< int, reloc_handle >;
+
+        V a{ reloc_handle{ std::make_unique< int >( 42 ) } };
+        V b{ 7 };
+        swap( a, b );
+        REQUIRE_EQ( a.index(), 0 );
+        REQUIRE_EQ( b.index(), 1 );
+        auto value = []( V& v ) {
+                return v.visit(
+                    [&]( int i ) {
+                            return i;
+                    },
+                    [&]( reloc_handle& h ) {
+                            return *h.p;
+                    } );
+        };
+        CHECK_EQ( value( a ), 7 );
+        CHECK_EQ( value( b ), 42 );
+
+        vopt< int, reloc_handle > c{ reloc_handle{ std::make_unique< int >( 1 ) } };
+        vopt< int, reloc_handle > d;
+        swap( c, d );
+        CHECK_FALSE( c );
+        CHECK( d );
+        swap( c, d );
+        CHECK( c );
+        CHECK_FALSE( d );
+
+        std::allocator< V > alloc;
+        V*                  src = alloc.allocate( 2 );
+        V*                  dst = alloc.allocate( 2 );
+        std::construct_at( src, std::move( a ) );
+        std::construct_at( src + 1, std::move( b ) );
+        CHECK_EQ( relocate_n( src, 2, dst ), dst + 2 );
+        CHECK_EQ( dst[0].index(), 0 );
+        CHECK_EQ( value( dst[1] ), 42 );
+        relocate_at( dst + 1, src );
+        CHECK_EQ( value( src[0] ), 42 );
+        std::destroy_at( dst );
+        std::destroy_at( src );
+        alloc.deallocate( src, 2 );
+        alloc.deallocate( dst, 2 );
+
+        using S = vval< int, std::string >;
+        S* ssrc = std::allocator< S >{}.allocate( 1 );
+        S* sdst = std::allocator< S >{}.allocate( 1 );
+        std::construct_at( ssrc, std::string( 64, 'x' ) );
+        relocate_at( ssrc, sdst );
+        CHECK_EQ( sdst->index(), 1 );
+        std::destroy_at( sdst );
+        std::allocator< S >{}.deallocate( ssrc, 1 );
+        std::allocator< S >{}.deallocate( sdst, 1 );
+}
+
+constexpr int constexpr_widen()
+{
+        vval< int, float > v{ 2.f };
+        auto               w = std::move( v ).template widen< vval< float, double, int > >();
+        return static_cast< int >( w.index() ) + ( v.index() == null_index ? 10 : 0 );
+}
+static_assert( constexpr_widen() == 10 );
+
+TEST_CASE( "widen" )
+{
+        auto value = []( auto& v ) {
+                return v.visit(
+                    [&]( int& i ) {
+                            return i;
+                    },
+                    [&]( float& f ) {
+                            return static_cast< int >( f );
+                    },
+                    [&]( reloc_handle& h ) {
+                            return *h.p;
+                    },
+                    [&]( std::string& s ) {
+                            return static_cast< int >( s.size() );
+                    } );
+        };
+
+        vval< int, reloc_handle > a{ reloc_handle{ std::make_unique< int >( 42 ) } };
+        auto w = std::move( a ).template widen< vval< float, int, reloc_handle, std::string > >();
+        CHECK_EQ( a.index(), null_index );
+        CHECK_EQ( w.index(), 2 );
+        CHECK_EQ( value( w ), 42 );
+
+        vval< std::string, int > s{ std::string( 64, 'x' ) };
+        auto ws = std::move( s ).template widen< vopt< float, int, reloc_handle, std::string > >();
+        CHECK_EQ( s.index(), null_index );
+        CHECK_EQ( ws.index(), 3 );
+        CHECK_EQ(
+            ws.visit(
+                [&]( std::string& x ) {
+                        return x.size();
+                },
+                [&]( vref< float, int, reloc_handle > ) {
+                        return std::size_t{ 0 };
+                },
+                [&]( empty_t ) {
+                        return std::size_t{ 0 };
+                } ),
+            64 );
+
+        vopt< int, reloc_handle > o;
+        auto wo = std::move( o ).template widen< vopt< int, reloc_handle, std::string > >();
+        CHECK_FALSE( wo );
+        o  = 5;
+        wo = std::move( o ).template widen< vopt< int, reloc_handle, std::string > >();
+        CHECK_FALSE( o );
+        CHECK_EQ( wo.index(), 0 );
+
+        static_assert( noexcept( std::move( a ).template widen< vval< int, reloc_handle > >() ) );
+
+        // bytewise conversion of trivially copyable types maps the index and keeps the source
+        vval< int, float > t{ 3.f };
+        vval< float, double, int > u{ t };
+        CHECK_EQ( u.index(), 0 );
+        CHECK_EQ( t.index(), 1 );
+        vopt< double, int, float > x{ std::move( t ) };
+        CHECK_EQ( x.index(), 2 );
+        vopt< int, float >         e;
+        vopt< float, int, double > y{ e };
+        CHECK_FALSE( y );
+}
+
 TEST_CASE( "vval_deref" )
 {
         vval< std::string > v1{ "wololo"s };
@@ -317,6 +758,16 @@ TEST_CASE( "vval_visit" )
 
         vval< std::vector< float >, int >        v6{ v5 };
         vval< std::vector< float >, int, float > v7{ std::move( v6 ) };
+
+        CHECK( v3.visit< dispatch_strategy::binary >( [&]( auto& item ) {
+                return std::is_same_v< decltype( item ), int& >;
+        } ) );
+        CHECK( v3.visit< dispatch_strategy::fun_table >( [&]( auto& item ) {
+                return std::is_same_v< decltype( item ), int& >;
+        } ) );
+        CHECK( v1.visit< dispatch_strategy::if_chain >( [&]( auto& item ) {
+                return std::is_same_v< decltype( item ), float& >;
+        } ) );
 }
 
 TEST_CASE( "vopt_visit" )
@@ -413,4 +864,95 @@ TEST_CASE( "vval construct from constref" )
         vopt< int const, float const > o3{ f1 };
 }
 
+TEST_CASE( "assign const alternative" )
+{
+        vval< int const, float > v{ 1 };
+        v = 2;
+        CHECK_EQ( v, vval< int const, float >{ 2 } );
+        v = 1.f;
+        v = 3;
+        CHECK_EQ( v, vval< int const, float >{ 3 } );
+
+        vopt< int const, float > o{ 1 };
+        o = 3;
+        CHECK_EQ( o, vopt< int const, float >{ 3 } );
+        o = 2.f;
+        CHECK_EQ( o, vopt< int const, float >{ 2.f } );
+}
+
+TEST_CASE( "hash" )
+{
+        using V = vval< int, float, std::string >;
+        std::hash< V > h;
+        CHECK_EQ( h( V{ 1 } ), h( V{ 1 } ) );
+        CHECK_EQ( h( V{ std::string{ "a" } } ), h( V{ std::string{ "a" } } ) );
+        CHECK_NE( h( V{ 1 } ), h( V{ 2 } ) );
+
+        using O = vopt< int, std::string >;
+        std::hash< O > ho;
+        CHECK_EQ( ho( O{} ), ho( O{} ) );
+        CHECK_EQ( ho( O{ 1 } ), ho( O{ 1 } ) );
+        CHECK_NE( ho( O{} ), ho( O{ 0 } ) );
+
+        static_assert( !std::is_default_constructible_v< std::hash< vval< std::vector< int > > > > );
+}
+
+struct bw_point
+{
+        int x;
+        int y;
+
+        friend bool operator==( bw_point const&, bw_point const& ) = default;
+};
+
+template <>
+struct is_bytewise_comparable< bw_point > : std::true_type
+{
+};
+
+static_assert( _all_bytewise_comparable_v< typelist< int, char const, bw_point, int* > > );
+static_assert( !_all_bytewise_comparable_v< typelist< int, float > > );
+static_assert( vval< int, char >{ 'a' } == vval< int, char >{ 'a' } );
+static_assert( vval< int, char >{ 1 } != vval< int, char >{ 'a' } );
+
+TEST_CASE( "bytewise" )
+{
+        using V = vval< int, char, bw_point >;
+        std::hash< V > h;
+        CHECK_EQ( V{ bw_point{ 1, 2 } }, V{ bw_point{ 1, 2 } } );
+        CHECK_NE( V{ bw_point{ 1, 2 } }, V{ bw_point{ 2, 1 } } );
+        CHECK_NE( V{ 1 }, V{ char{ 1 } } );
+        CHECK_EQ( h( V{ 'x' } ), h( V{ 'x' } ) );
+        CHECK_EQ( h( V{ bw_point{ 1, 2 } } ), h( V{ bw_point{ 1, 2 } } ) );
+        CHECK_EQ( h( V{ 42 } ), _val_core< V::types >::hash_item( V{ 42 }.index(), 42 ) );
+
+        // mixed sets use bytewise comparison only for some of the types
+        using M = vopt< int, float, bw_point >;
+        CHECK_EQ( M{ bw_point{ 3, 4 } }, M{ bw_point{ 3, 4 } } );
+        CHECK_NE( M{ 0.f }, M{ 0 } );
+        CHECK_EQ( M{ 0.f }, M{ -0.f } );
+        CHECK_EQ( std::hash< M >{}( M{ 5 } ), std::hash< M >{}( M{ 5 } ) );
+
+        std::vector< V > a{ V{ 1 }, V{ 'c' }, V{ bw_point{ 1, 2 } } };
+        std::vector< V > b = a;
+        CHECK( equal( std::span{ a }, std::span< V const >{ b } ) );
+        CHECK_EQ( hash( std::span{ a } ), hash( std::span{ b } ) );
+        b[1] = V{ 'd' };
+        CHECK_FALSE( equal( std::span{ a }, std::span{ b } ) );
+        CHECK_NE( hash( std::span{ a } ), hash( std::span{ b } ) );
+        b.pop_back();
+        CHECK_FALSE( equal( std::span{ a }, std::span{ b } ) );
+
+        // Values emptied by widen compare equal and hash without touching the storage
+        V    e1{ 1 };
+        V    e2{ 'x' };
+        auto w1 = std::move( e1 ).template widen< vval< int, char, bw_point, long > >();
+        auto w2 = std::move( e2 ).template widen< vval< int, char, bw_point, long > >();
+        CHECK_EQ( e1.index(), null_index );
+        CHECK_EQ( e2.index(), null_index );
+        CHECK( e1 == e2 );
+        CHECK_EQ( h( e1 ), h( e2 ) );
+        CHECK_FALSE( e1 == V{ 1 } );
+}
+
 }  // namespace vari
@@ -0,0 +1,185 @@
+/// MIT License
+///
+/// Copyright (c) 2025 koniarik
+///
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in all
+/// copies or substantial portions of the Software.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+/// SOFTWARE.
+#include "vari/vvector.h"
+
+#include <doctest/doctest.h>
+#include <string>
+
+namespace vari
+{
+
+template < typename T >
+concept vvector_arithmetic = std::is_arithmetic_v< T >;
+
+static_assert( std::same_as<
+               vvector< typelist< int, float >, int, std::string >,
+               _vvector< float, int, std::string > > );
+static_assert( std::ranges::forward_range< _vvector_segment< int > > );
+static_assert( std::ranges::forward_range< _vvector_segment< int > const > );
+
+TEST_CASE( "vvector" )
+{
+        vvector< int, float, std::string > v;
+        CHECK( v.empty() );
+
+        v.emplace< std::string >( 3, 'a' );
+        v.push_back( 1 );
+        v.push_back( 2.f );
+        v.push_back( 3 );
+        v.push_back( std::string{ "b" } );
+
+        CHECK_EQ( v.size(), 5 );
+        CHECK_EQ( v.size< int >(), 2 );
+        CHECK_EQ( v.segment< int >()[1], 3 );
+        CHECK_EQ( v.segment< std::string >()[0], "aaa" );
+
+        // References stay valid while other segments grow
+        int& i = v.emplace< int >( 4 );
+        for ( int k = 0; k < 100; k++ )
+                v.push_back( std::string{ "x" } );
+        CHECK_EQ( &i, &v.segment< int >()[2] );
+        v.clear();
+        CHECK( v.empty() );
+
+        v.push_back( std::string{ "s" } );
+        v.push_back( 1 );
+        v.push_back( 2.f );
+        v.push_back( 3 );
+
+        std::string order;
+        v.for_each(
+            [&]( int& x ) {
+                    order += std::to_string( x );
+                    x += 10;
+            },
+            [&]( float& ) {
+                    order += 'f';
+            },
+            [&]( std::string& x ) {
+                    order += x;
+            } );
+        CHECK_EQ( order, "13fs" );
+
+        vvector< int, float, std::string > const& cv = v;
+        int                                       sum = 0;
+        cv.for_each(
+            [&]( vvector_arithmetic auto const& x ) {
+                    sum += static_cast< int >( x );
+            },
+            [&]( std::string const& ) {} );
+        CHECK_EQ( sum, 26 );
+
+        vref< int, float, std::string > r = v.at( 2 );
+        CHECK_EQ( r.visit(
+                      [&]( float& ) {
+                              return 1;
+                      },
+                      [&]( int& ) {
+                              return 0;
+                      },
+                      [&]( std::string& ) {
+                              return 0;
+                      } ),
+                  1 );
+        vref< int const, float const, std::string const > s = cv.at( 3 );
+        s.visit(
+            [&]( std::string const& x ) {
+                    CHECK_EQ( x, "s" );
+            },
+            [&]( vvector_arithmetic auto const& ) {
+                    FAIL( "" );
+            } );
+
+        CHECK( v.ptr_at( 0 ) );
+        CHECK_FALSE( v.ptr_at( 4 ) );
+        vptr< int const, float const, std::string const > p = cv.ptr_at( 1 );
+        p.visit(
+            [&]( empty_t ) {
+                    FAIL( "" );
+            },
+            [&]( vvector_arithmetic auto const& x ) {
+                    CHECK_EQ( x, 13 );
+            },
+            [&]( std::string const& ) {
+                    FAIL( "" );
+            } );
+}
+
+TEST_CASE( "vvector_stable" )
+{
+        vvector< int, std::string > v;
+
+        // References survive any number of insertions of any type
+        int&                     first = v.emplace< int >( 1 );
+        std::string&             str   = v.emplace< std::string >( 100, 's' );
+        vref< int, std::string > r{ first };
+        std::vector< int* >      ptrs{ &first };
+        for ( int k = 1; k < 5000; k++ ) {
+                ptrs.push_back( &v.push_back( k + 1 ) );
+                v.push_back( std::to_string( k ) );
+        }
+        CHECK_EQ( v.size< int >(), 5000 );
+        CHECK_EQ( &first, &v.segment< int >()[0] );
+        CHECK_EQ( &str, &v.segment< std::string >()[0] );
+        CHECK_EQ( r, v.at( 0 ) );
+        for ( int k = 0; k < 5000; k++ ) {
+                CHECK_EQ( ptrs[k], &v.segment< int >()[k] );
+                CHECK_EQ( *ptrs[k], k + 1 );
+        }
+
+        // Iteration keeps the order of insertion across the blocks
+        int  expected = 1;
+        bool ordered  = true;
+        for ( int const& x : v.segment< int >() )
+                ordered &= x == expected++;
+        CHECK( ordered );
+        std::size_t chunks = 0;
+        v.segment< int >().for_each_chunk( [&]( std::span< int > c ) {
+                CHECK_FALSE( c.empty() );
+                chunks++;
+        } );
+        CHECK_GT( chunks, 1 );
+
+        // Reserved capacity is used without further allocation
+        vvector< int > w;
+        w.reserve< int >( 100 );
+        std::size_t const cap = w.capacity< int >();
+        CHECK_GE( cap, 100 );
+        for ( int k = 0; k < 100; k++ )
+                w.push_back( k );
+        CHECK_EQ( w.capacity< int >(), cap );
+
+        // Copies are deep, clear keeps the blocks
+        vvector< int, std::string > c = v;
+        CHECK_EQ( c.size(), v.size() );
+        CHECK_NE( &c.segment< int >()[0], &first );
+        CHECK_EQ( c.segment< std::string >()[4999], "4999" );
+        std::size_t const vcap = v.capacity< int >();
+        v.clear();
+        CHECK( v.empty() );
+        CHECK_EQ( v.capacity< int >(), vcap );
+        CHECK_EQ( v.segment< int >().begin(), v.segment< int >().end() );
+        v.push_back( 7 );
+        CHECK_EQ( v.segment< int >()[0], 7 );
+}
+
+}  // namespace vari